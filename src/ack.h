@@ -254,6 +254,8 @@ struct  descriptor_data
     CHAR_DATA *         character;
     CHAR_DATA *         original;
     char *              host;
+    char                ip              [16];
+    time_t              resolve_wait;   /* give up on DNS after this */
     sh_int              descriptor;
     sh_int              connected;
     bool                fcommand;
@@ -266,6 +268,15 @@ struct  descriptor_data
     char *              outbuf;
     int                 outsize;
     int                 outtop;
+    int                 outflush;     /* output the socket wouldn't take */
+    OUT_QUEUE *         first_outq;   /* queued output, see write_segment */
+    OUT_QUEUE *         last_outq;
+    int                 outmark;      /* outbuf up to here is queued */
+    int                 outqueued;    /* bytes of shared segments queued */
+    int                 outpeak;      /* most output ever queued */
+    int                 outdropped;   /* messages shed while flooded */
+    time_t              outflood;     /* when it last went over the mark */
+    int                 ioready;      /* NP_* bits from this pulse's poll */
     unsigned int	remote_port;	/* 'Pair Port' ? -S- */
     int			check;		/* For new players*/
     int                 flags;
@@ -275,6 +286,67 @@ struct  descriptor_data
 
 #define DESC_FLAG_PASSTHROUGH 1     /* Used when data is being passed to */
 				     /*	Another prog.                     */
+#define DESC_FLAG_OUTBLOCKED  2     /* Waiting for the socket to drain  */
+#define DESC_FLAG_OUTFLOODED  4     /* Over OUT_HIGH_WATER              */
+#define DESC_FLAG_OUTSHED     8     /* Shed something this flood        */
+#define DESC_FLAG_PROMPTDUE   16    /* Prompt held back until it drains */
+
+#define HAS_OUTPUT(d)	( (d)->outtop > 0 || (d)->first_outq != NULL )
+#define OUT_PENDING(d)	( (d)->outtop + (d)->outqueued )
+
+/*
+ * Output shared between descriptors.  A broadcast is colour-expanded
+ * once for each colour setting among its readers into an OUT_SEG, and
+ * each reader queues a reference to that instead of a copy.  A reader's
+ * output is its queue in order, then whatever is in outbuf past outmark;
+ * queue entries with no seg are runs of outbuf.
+ */
+struct out_seg
+{
+    int                 refs;
+    int                 len;
+    char *              text;         /* follows the struct */
+};
+
+struct out_queue
+{
+    bool		is_free;
+    OUT_QUEUE *         next;
+    OUT_QUEUE *         prev;
+    OUT_SEG *           seg;          /* NULL for a run of outbuf */
+    int                 start;
+    int                 end;
+};
+
+struct out_cast
+{
+    const char *        txt;
+    int                 len;
+    int                 lines;
+    int                 top;
+    int                 mode            [OUT_CAST_MODES];
+    OUT_SEG *           seg             [OUT_CAST_MODES];
+};
+
+/*
+ * Each freelist's objects come from slabs of its own (see slab.c), kept
+ * in a SLAB_TYPE named after the freelist, like its destructor.
+ */
+struct slab_type
+{
+    const char *        name;
+    SLAB_TYPE *         next;
+    SLAB *              first_slab;
+    SLAB *              last_slab;
+    SLAB *              current;      /* the one being carved up */
+    int                 size;
+    int                 stride;
+    int                 next_offset;  /* of the freelist link */
+    int                 per_slab;
+    int                 slabs;
+    int                 live;
+    int                 free;
+};
 
 
 
@@ -352,6 +424,7 @@ struct  help_data
     sh_int      level;
     char *      keyword;
     char *      text;
+    int		search;	/* last help_search to count it */
 };
 
 
@@ -634,6 +707,12 @@ struct  char_data
     AFFECT_DATA *	first_saved_aff;
     AFFECT_DATA *	last_saved_aff;
     NOTE_DATA *         pnote;
+    OBJ_DATA *          worn            [MAX_WEAR];  /* see get_eq_char */
+    NAME_KEY *          name_keys;      /* see get_char_world */
+    long                list_order;     /* place in first_char, from 1 */
+    CHAR_DATA *         next_kind;      /* in_room's pc or aggressor list */
+    CHAR_DATA *         prev_kind;
+    sh_int              room_kind;      /* which of them, see char_to_room */
     OBJ_DATA *          first_carry;
     OBJ_DATA *		last_carry;
     ROOM_INDEX_DATA *   in_room;
@@ -682,6 +761,7 @@ struct  char_data
     int                 act_build;      /* for setting what ya editing */
     int                 build_vnum;     /* the current vnum for w-y-e  */
     int                 affected_by;
+    int                 worn_apply;     /* item_apply of all that's worn */
     sh_int              position;
     sh_int              practice;
     float              carry_weight;
@@ -703,6 +783,8 @@ struct  char_data
     MPROG_ACT_LIST *    first_mpact;                  /* Used by MOBprogram */
     MPROG_ACT_LIST *	last_mpact;
     int                 mpactnum;               /* Used by MOBprogram */
+    CHAR_DATA *         next_mpact_ch;          /* mobs with mpacts waiting */
+    CHAR_DATA *         prev_mpact_ch;
     int			skills;			/* Used for MOBs */
     int			cast;
     int			def;
@@ -1183,6 +1265,7 @@ struct  area_data
     char *		level_label;
     sh_int		reset_rate;
     char *		reset_msg;
+    int			hunt_id;	/* see h_area_build */
 };
 
 
@@ -1219,6 +1302,13 @@ struct  room_index_data
     MARK_LIST_MEMBER	*first_mark_list;
     MARK_LIST_MEMBER	*last_mark_list;
     MONEY_TYPE * treasure;
+    int			hunt_id;	/* see h_find_dir */
+    CHAR_DATA *		first_pc;	/* players here, for aggr_update */
+    CHAR_DATA *		last_pc;
+    CHAR_DATA *		first_aggr;	/* aggressive mobs here */
+    CHAR_DATA *		last_aggr;
+    ROOM_INDEX_DATA *	next_hot;	/* on the hot room list */
+    ROOM_INDEX_DATA *	prev_hot;
    
 };
 
@@ -1368,6 +1458,8 @@ void    load_messages           args( ( void ) );
 
 /* comm.c */
 void    close_socket    args( ( DESCRIPTOR_DATA *dclose ) );
+void    host_resolved   args( ( DESCRIPTOR_DATA *d ) );
+BAN_DATA * check_ban    args( ( DESCRIPTOR_DATA *d, bool fNewbie ) );
 void    show_menu_to	args( ( DESCRIPTOR_DATA *d ) ); /* Main */
  void    show_amenu_to   args( ( DESCRIPTOR_DATA *d ) ); /* Attributes */
  void    show_rmenu_to   args( ( DESCRIPTOR_DATA *d ) ); /* Race */
@@ -1375,10 +1467,17 @@ void    show_menu_to	args( ( DESCRIPTOR_DATA *d ) ); /* Main */
  void    show_cmenu_to   args( ( DESCRIPTOR_DATA *d ) ); /* Class */
  void    write_to_buffer args( ( DESCRIPTOR_DATA *d, const char *txt,
  			    int length ) );
+ void    discard_output  args( ( DESCRIPTOR_DATA *d ) );
+ bool    output_shed     args( ( DESCRIPTOR_DATA *d ) );
+ void    cast_init       args( ( OUT_CAST *cast, const char *txt ) );
+ void    cast_to         args( ( OUT_CAST *cast, DESCRIPTOR_DATA *d ) );
+ void    cast_done       args( ( OUT_CAST *cast ) );
  void    send_to_char    args( ( const char *txt, CHAR_DATA *ch ) );
  void    show_string     args( ( DESCRIPTOR_DATA *d, char *input ) );
  void    act             args( ( const char *format, CHAR_DATA *ch,
  			    const void *arg1, const void *arg2, int type ) );
+ int     act_format      args( ( char *buf, const char *format, CHAR_DATA *ch,
+ 			    const void *arg1, const void *arg2, CHAR_DATA *to ) );
  void    hang            args( ( const char *str ) );
  
  /* db.c */
@@ -1485,6 +1584,7 @@ void    extract_char    args( ( CHAR_DATA *ch, bool fPull ) );
 CD *    get_char_room   args( ( CHAR_DATA *ch, char *argument ) );
 CD *    get_char_world  args( ( CHAR_DATA *ch, char *argument ) );
 CD *    get_char_area   args( ( CHAR_DATA *ch, char *argument ) );
+CD *    get_player_world args( ( CHAR_DATA *ch, char *argument ) );
 OD *    get_obj_type    args( ( OBJ_INDEX_DATA *pObjIndexData ) );
 OD *    get_obj_list    args( ( CHAR_DATA *ch, char *argument,
 			    OBJ_DATA *list ) );
@@ -1510,7 +1610,14 @@ void    notify          args( ( char * message, int lv 		) );
 void    info            args( ( char * message, int lv 		) );
 void    auction		args( ( char * message 			) );
 void    log_chan	args( ( const char * message, int lv 	) );
-bool    item_has_apply  args( ( CHAR_DATA *ch, int bit 		) );
+void    char_apply_update args( ( CHAR_DATA *ch 			) );
+int     worn_check      args( ( void 				) );
+void    set_item_apply  args( ( OBJ_DATA *obj, int bits, bool fSet	) );
+void    char_to_list    args( ( CHAR_DATA *ch 			) );
+void    char_rename     args( ( CHAR_DATA *ch, char *name		) );
+int     name_check      args( ( void 				) );
+int     room_kind_check args( ( void 				) );
+void    room_kind_update args( ( CHAR_DATA *ch			) );
 CD   *  switch_char	args( ( CHAR_DATA *victim, int mvnum, int poly_level ) );
 CD   *  unswitch_char   args( ( CHAR_DATA *ch 			) );
 int	best_class	args( ( CHAR_DATA *ch, int sn 		) );
@@ -1534,6 +1641,8 @@ bool    is_shielded     args( ( CHAR_DATA *ch, sh_int shield_type ) );
 void    remove_shield   args( ( CHAR_DATA *ch, MAGIC_SHIELD *shield ) );
 bool    authorized      args( ( CHAR_DATA *ch, char *skllnm ) );
 bool	check_social	args( ( CHAR_DATA *ch, char *command, char *argument ) );
+void	cmd_stat_update	args( ( void ) );
+void	build_social_trie args( ( void ) );
 
 
 
@@ -1691,11 +1800,30 @@ void	char_hunt	args( ( CHAR_DATA *ch  ) );
 void	end_hunt	args( ( CHAR_DATA *ch ) );  
 sh_int h_find_dir       args( ( ROOM_INDEX_DATA *room, ROOM_INDEX_DATA *target,
                    int h_flags ) );
+void	hunt_graph_changed args( ( void ) );
+void	hunt_doors_changed args( ( void ) );
 
   /* update.c */
 
 void init_alarm_handler args(  ( void ) );
 void alarm_update args( ( void ) );
+long long current_usec args( ( void ) );
+void pulse_sleep args( ( void ) );
+long long pulse_idle args( ( void ) );
+
+/*
+ *  pulsestat.c
+ */
+void	pstat_record	args( ( int which, long long start ) );
+
+/*
+ *  memstat.c
+ */
+int	mem_site	args( ( const char *caller, int kind ) );
+void	mem_count	args( ( int site, long bytes ) );
+void *	mem_get		args( ( int size, const char *caller, int kind ) );
+void	mem_put		args( ( void *mem ) );
+int	mem_check_shared args( ( void ) );
 /*    SSM   */
 void temp_fread_string	args( (FILE * fp, char *buf) );
 
@@ -1721,6 +1849,39 @@ void save_brands	args( ( void ) );
 void load_sysdata	args( ( void ) );
 void save_sysdata	args( ( void ) );
 
+/*
+ *  resolve.c
+ */
+void	resolve_init	args( ( void ) );
+bool	resolve_host	args( ( DESCRIPTOR_DATA *d ) );
+void	resolve_update	args( ( void ) );
+void	resolve_forget	args( ( DESCRIPTOR_DATA *d ) );
+void	resolve_markstrings args( ( void (*touch)( char *str ) ) );
+
+/*
+ *  helpidx.c
+ */
+void	help_index_add	args( ( HELP_DATA *pHelp ) );
+HELP_DATA *help_lookup	args( ( const char *argument, int level,
+				int number ) );
+HELP_DATA *help_search	args( ( CHAR_DATA *ch, char *argument ) );
+void	help_markstrings args( ( void (*touch)( char *str ) ) );
+
+/*
+ *  slab.c
+ */
+void *	slab_alloc	args( ( SLAB_TYPE *type, int size,
+				const char *caller ) );
+void	slab_get	args( ( void *obj, const char *caller ) );
+void	slab_put	args( ( void *obj, int next_offset ) );
+void	slab_trim	args( ( SLAB_TYPE *type, void **freelist ) );
+void	slab_report	args( ( CHAR_DATA *ch ) );
+
+/*
+ *  lists.c
+ */
+void	slab_trim_all	args( ( void ) );
+
 
 #undef  CD
 #undef  MID
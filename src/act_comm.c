@@ -694,6 +694,31 @@ void talk_channel( CHAR_DATA *ch, char *argument, int channel, const char *verb
    }
    {
      bool has_howled = FALSE;
+     char v_text[OUT_CAST_MODES][MAX_STRING_LENGTH];
+     const char *v_pre[OUT_CAST_MODES];
+     const char *v_post[OUT_CAST_MODES];
+     bool v_seen[OUT_CAST_MODES];
+     OUT_CAST v_cast[OUT_CAST_MODES];
+     char *col;
+     const char *pre, *post;
+     bool seen;
+     int top = 0;
+     int i;
+
+     /* Each reader's own colour for the channel wraps the message. */
+     switch ( channel )
+     {
+	default:		col = NULL;		break;
+	case CHANNEL_SHOUT:	col = "shout";		break;
+	case CHANNEL_RACE:	col = "race";		break;
+	case CHANNEL_MUSIC:	col = "music";		break;
+	case CHANNEL_CLAN:	col = "clan";		break;
+	case CHANNEL_FLAME:	col = "flame";		break;
+	case CHANNEL_YELL:	col = "yell";		break;
+	case CHANNEL_GOSSIP:
+	case CHANNEL_OOC:
+	case CHANNEL_CRUSADE:	col = "gossip";		break;
+     }
 
      for ( d = first_desc; d != NULL; d = d->next )
      {
@@ -757,60 +782,52 @@ void talk_channel( CHAR_DATA *ch, char *argument, int channel, const char *verb
                continue;
              }
            }
+	    pre  = col != NULL ? color_string( vch, col ) : "";
+	    post = col != NULL ? color_string( vch, "normal" ) : "";
+	    sprintf( ansi, "%s%s%s", pre, buf, post );
+
+	    /*
+	     * Readers with the same colours who see the speaker the same
+	     * way share one rendering.  Switched immortals still go
+	     * through act(), which runs the mob's act programs.
+	     */
+	    if ( !IS_NPC( vch ) )
+	    {
+		if ( ( channel == CHANNEL_SHOUT || channel == CHANNEL_YELL )
+		&&   !IS_AWAKE( vch ) )
+		    continue;
+		seen = can_see( vch, ch );
+		for ( i = 0; i < top; i++ )
+		    if ( v_pre[i] == pre && v_post[i] == post && v_seen[i] == seen )
+			break;
+		if ( i == top && top < OUT_CAST_MODES )
+		{
+		    act_format( v_text[i], ansi, ch, argument, vch, vch );
+		    cast_init( &v_cast[i], v_text[i] );
+		    v_pre[i]  = pre;
+		    v_post[i] = post;
+		    v_seen[i] = seen;
+		    top++;
+		}
+		if ( i < top )
+		{
+		    cast_to( &v_cast[i], d );
+		    continue;
+		}
+	    }
 
+	    if ( output_shed( d ) )
+		continue;
 	    position            = vch->position;
 	    if ( channel != CHANNEL_SHOUT && channel != CHANNEL_YELL )
 		vch->position   = POS_STANDING;
-	    
-	    switch ( channel )
-	    {
-	       default:
-	          sprintf( ansi, "%s", buf );
-	          break;
-	       case CHANNEL_SHOUT:
-	          sprintf( ansi, "%s%s%s", color_string( vch, "shout" ),
-	                   buf, color_string( vch, "normal" ) );
-	          break;
-	       case CHANNEL_RACE:
-	          sprintf( ansi, "%s%s%s", color_string( vch, "race" ),
-	          	   buf, color_string( vch, "normal" ) );
-	          break;
-	       case CHANNEL_MUSIC:
-	          sprintf( ansi, "%s%s%s", color_string( vch, "music" ),
-	          	   buf, color_string( vch, "normal" ) );
-	          break;
-	       case CHANNEL_CLAN:
-	          sprintf( ansi, "%s%s%s", color_string( vch, "clan" ),
-	                   buf, color_string( vch, "normal" ) );
-	          break;
-	       case CHANNEL_FLAME:
-	          sprintf( ansi, "%s%s%s", color_string( vch, "flame" ),
-	                   buf, color_string( vch, "normal" ) );
-	          break;
-	       case CHANNEL_YELL:
-	          sprintf( ansi, "%s%s%s", color_string( vch, "yell" ),
-	                   buf, color_string( vch, "normal" ) );
-	          break;
-	       case CHANNEL_GOSSIP:
-	          sprintf( ansi, "%s%s%s", color_string( vch, "gossip" ),
-	                   buf, color_string( vch, "normal" ) );
-	          break;
-	       case CHANNEL_OOC:
-	          sprintf( ansi, "%s%s%s", color_string( vch, "gossip" ), 
-	                   buf, color_string( vch, "normal" ) );
-	          break;
- 
-	       case CHANNEL_CRUSADE:
-	          sprintf( ansi, "%s%s%s", color_string( vch, "gossip" ),
-	                   buf, color_string( vch, "normal" ) );
-	          break;
-
-	    }
 	    act( ansi, ch, argument, vch, TO_VICT );
 	    vch->position       = position;
 	}
     }
 
+    for ( i = 0; i < top; i++ )
+	cast_done( &v_cast[i] );
     return;
    }
 }
@@ -1307,7 +1324,8 @@ void do_tell( CHAR_DATA *ch, char *argument )
      * -- Stephen
      */
 
-    if ( ( victim = get_char_world( ch, arg ) ) == NULL )
+    if ( ( victim = get_player_world( ch, arg ) ) == NULL
+    &&   ( victim = get_char_world( ch, arg ) ) == NULL )
     {
 	send_to_char( "They aren't here.\n\r", ch );
 	return;
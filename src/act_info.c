@@ -389,7 +389,7 @@ void show_char_to_char_0( CHAR_DATA *victim, CHAR_DATA *ch )
     if ( IS_NPC( victim ) )
     {
        if ( IS_SET( victim->act, ACT_UNDEAD ) &&
-	  ( is_affected( ch, skill_lookup( "detect undead" ) ) || item_has_apply( ch, ITEM_APPLY_DET_UNDEAD ) ) )
+	  ( is_affected( ch, gsn_detect_undead ) || item_has_apply( ch, ITEM_APPLY_DET_UNDEAD ) ) )
 	  safe_strcat(MAX_STRING_LENGTH, buf, "(UnDead) " );
     
        if ( IS_SET( victim->act, ACT_INTELLIGENT ) )
@@ -440,7 +440,7 @@ void show_char_to_char_0( CHAR_DATA *victim, CHAR_DATA *ch )
     if (  ( IS_AFFECTED( victim, AFF_CLOAK_FLAMING ) )
        || ( IS_AFFECTED( victim, AFF_CLOAK_ABSORPTION ) ) 
 	 || ( IS_AFFECTED( victim, AFF_CLOAK_REFLECTION ) ) 
-   || ( is_affected( victim, skill_lookup( "cloak:misery" ) )  ) )
+   || ( is_affected( victim, gsn_cloak_misery )  ) )
     {
       safe_strcat( MAX_STRING_LENGTH, buf, "  @@NCLOAK:" );
       if ( IS_AFFECTED( victim, AFF_CLOAK_FLAMING ) )
@@ -449,7 +449,7 @@ void show_char_to_char_0( CHAR_DATA *victim, CHAR_DATA *ch )
         safe_strcat( MAX_STRING_LENGTH, buf, " @@lABSORB@@N" );
       if ( IS_AFFECTED( victim, AFF_CLOAK_REFLECTION ) )
         safe_strcat( MAX_STRING_LENGTH, buf, " @@mREFLECT@@N" );
-      if ( is_affected( victim, skill_lookup( "cloak:misery" ) ) )
+      if ( is_affected( victim, gsn_cloak_misery ) )
         safe_strcat( MSL, buf, " @@RMISERY@@N" );
       safe_strcat( MAX_STRING_LENGTH, buf, "\n\r" );
     }
@@ -532,7 +532,7 @@ void show_char_to_char_0( CHAR_DATA *victim, CHAR_DATA *ch )
 	 || ( IS_AFFECTED( victim, AFF_CLOAK_REGEN ) )  
        || ( IS_AFFECTED( victim, AFF_CLOAK_ABSORPTION ) ) 
 	 || ( IS_AFFECTED( victim, AFF_CLOAK_REFLECTION ) ) 
-   || ( is_affected( victim, skill_lookup( "cloak:misery" ) ) ) )
+   || ( is_affected( victim, gsn_cloak_misery ) ) )
     {
       safe_strcat( MAX_STRING_LENGTH, buf, "  @@NCLOAK:" );
       if ( IS_AFFECTED( victim, AFF_CLOAK_FLAMING ) )
@@ -546,7 +546,7 @@ void show_char_to_char_0( CHAR_DATA *victim, CHAR_DATA *ch )
 	safe_strcat( MAX_STRING_LENGTH, buf, " @@WADEPT@@N" );
       if ( IS_AFFECTED( victim, AFF_CLOAK_REGEN ) )
 	safe_strcat( MAX_STRING_LENGTH, buf, " @@rREGEN@@N" );
-      if ( is_affected( victim, skill_lookup( "cloak:misery" ) ) )
+      if ( is_affected( victim, gsn_cloak_misery ) )
         safe_strcat( MSL, buf, " @@RMISERY@@N" );      
       safe_strcat( MAX_STRING_LENGTH, buf, "\n\r" );
    
@@ -789,7 +789,7 @@ void do_look( CHAR_DATA *ch, char *argument )
 	
 	/* Show any room-affects */
 	if (  ( ch->in_room->affected_by != 0 ) 
-	 && ( ( is_affected( ch, skill_lookup( "detect magic" ) ) )  
+	 && ( ( is_affected( ch, gsn_detect_magic ) )  
 	    || ( item_has_apply( ch, ITEM_APPLY_DET_MAG ) )  ) )
         {
 	   sprintf( out, "%s", color_string( ch, "rooms" ) );
@@ -1768,31 +1768,24 @@ void do_help( CHAR_DATA *ch, char *argument )
     if ( argument[0] == '\0' )
 	argument = "summary";
 
-    for ( pHelp = first_help; pHelp != NULL; pHelp = pHelp->next )
-    {
-	if ( pHelp->level > get_trust( ch ) )
-	    continue;
-
-	if ( is_name( argument, pHelp->keyword ) )
-	{
-	    if ( pHelp->level >= 0 && str_cmp( argument, "imotd" ) )
-	    {
-		send_to_char( pHelp->keyword, ch );
-		send_to_char( "\n\r", ch );
-	    }
+    /* help_search says what it found if it isn't just the one */
+    if ( ( pHelp = help_lookup( argument, get_trust( ch ), 1 ) ) == NULL
+    &&   ( pHelp = help_search( ch, argument ) ) == NULL )
+	return;
 
-	    /*
-	     * Strip leading '.' to allow initial blanks.
-	     */
-	    if ( pHelp->text[0] == '.' )
-		send_to_char( pHelp->text+1, ch );
-	    else
-		send_to_char( pHelp->text  , ch );
-	    return;
-	}
+    if ( pHelp->level >= 0 && str_cmp( argument, "imotd" ) )
+    {
+	send_to_char( pHelp->keyword, ch );
+	send_to_char( "\n\r", ch );
     }
 
-    send_to_char( "No help on that word.\n\r", ch );
+    /*
+     * Strip leading '.' to allow initial blanks.
+     */
+    if ( pHelp->text[0] == '.' )
+	send_to_char( pHelp->text+1, ch );
+    else
+	send_to_char( pHelp->text  , ch );
     return;
 }
 
@@ -5134,7 +5127,7 @@ void do_heal( CHAR_DATA *ch, char *argument )
 	 }
 	 act( "$N gestures towards $n.", ch, NULL, mob, TO_NOTVICT );
 	 act( "$N gestures towards you.", ch, NULL, mob, TO_CHAR );
-	 spell_sanctuary( skill_lookup( "sanc" ), mult, ch, ch, NULL );
+	 spell_sanctuary( gsn_sanctuary, mult, ch, ch, NULL );
 	 give = take_best_coins( ch->money,  ( mult * 100 ) );
    give = one_argument( give, changebuf );
    sprintf( givebuf, "%s to %s", give, mob->name );
@@ -5167,7 +5160,7 @@ void do_heal( CHAR_DATA *ch, char *argument )
 	 }
 	 act( "$N gestures towards $n.", ch, NULL, mob, TO_NOTVICT );
 	 act( "$N gestures towards you.", ch, NULL, mob, TO_CHAR );
-	 spell_heal( skill_lookup( "heal" ), mult, mob, ch, NULL );
+	 spell_heal( gsn_heal, mult, mob, ch, NULL );
 	 give = take_best_coins( ch->money,( mult * 50 ) );
    give = one_argument( give, changebuf );
    sprintf( givebuf, "%s to %s", give, mob->name );
@@ -5183,7 +5176,7 @@ void do_heal( CHAR_DATA *ch, char *argument )
 	 }
 	 act( "$N gestures towards $n.", ch, NULL, mob, TO_NOTVICT );
 	 act( "$N gestures towards you.", ch, NULL, mob, TO_CHAR );
-	 spell_invis( skill_lookup( "invis" ), mult, mob, ch, NULL );
+	 spell_invis( gsn_invis, mult, mob, ch, NULL );
 	 give = take_best_coins( ch->money,( mult * 20 ));
    give = one_argument( give, changebuf );
    sprintf( givebuf, "%s to %s", give, mob->name );
@@ -5199,7 +5192,7 @@ void do_heal( CHAR_DATA *ch, char *argument )
 	 }
 	 act( "$N gestures towards $n.", ch, NULL, mob, TO_NOTVICT );
 	 act( "$N gestures towards you.", ch, NULL, mob, TO_CHAR );
-	 spell_detect_invis( skill_lookup( "detect invis" ), mult, mob, ch, NULL );        
+	 spell_detect_invis( gsn_detect_invis, mult, mob, ch, NULL );        
 	 give = take_best_coins( ch->money, ( mult * 10 ) );
    give = one_argument( give, changebuf );
    sprintf( givebuf, "%s to %s", give, mob->name );
@@ -5215,7 +5208,7 @@ void do_heal( CHAR_DATA *ch, char *argument )
 	 }
 	 act( "$N gestures towards $n.", ch, NULL, mob, TO_NOTVICT );
 	 act( "$N gestures towards you.", ch, NULL, mob, TO_CHAR );
-	 spell_refresh( skill_lookup( "refresh" ), mult, mob, ch, NULL );      
+	 spell_refresh( gsn_refresh, mult, mob, ch, NULL );      
 	 give = take_best_coins( ch->money,( mult * 10 )); 
    give = one_argument( give, changebuf );
    sprintf( givebuf, "%s to %s", give, mob->name );
@@ -5231,7 +5224,7 @@ void do_heal( CHAR_DATA *ch, char *argument )
 	 }
 	 act( "$N gestures towards $n.", ch, NULL, mob, TO_NOTVICT );
 	 act( "$N gestures towards you.", ch, NULL, mob, TO_CHAR );
-	 spell_infravision( skill_lookup( "infra" ), mult, ch, ch, NULL );
+	 spell_infravision( gsn_infravision, mult, ch, ch, NULL );
 	 give = take_best_coins( ch->money,( mult * 20 ) );
    give = one_argument( give, changebuf );
    sprintf( givebuf, "%s to %s", give, mob->name );
@@ -5246,7 +5239,7 @@ void do_heal( CHAR_DATA *ch, char *argument )
 	    return;
 	 }
 	 /* No acts, as they are in spell_dispel_magic.  Doh. */
-	 spell_dispel_magic( skill_lookup( "dispel magic" ), mult*5, mob, ch, NULL );
+	 spell_dispel_magic( gsn_dispel_magic, mult*5, mob, ch, NULL );
 	 give = take_best_coins( ch->money,( mult * 200 ) );
    give = one_argument( give, changebuf );
    sprintf( givebuf, "%s to %s", give, mob->name );
@@ -6043,7 +6036,7 @@ void do_whois( CHAR_DATA *ch, char *argument )
    CHAR_DATA *victim;
    char buf[MAX_STRING_LENGTH];
 
-   if ( ( victim = get_char_world( ch, argument ) ) == NULL )
+   if ( ( victim = get_player_world( ch, argument ) ) == NULL )
    {
       send_to_char( "No such player found.\n\r", ch );
       return;
@@ -6122,8 +6115,10 @@ void do_shelp( CHAR_DATA *ch, char * argument )
    /* Like help, except for spells and skills. */
    int sn;
    char buf[MAX_STRING_LENGTH];
+   char arg[MAX_INPUT_LENGTH];
    HELP_DATA *pHelp;
    bool found = FALSE;
+   int n;
     buf[0] = '\0';
 
    if ( argument[0] == '\0' )
@@ -6141,7 +6136,8 @@ void do_shelp( CHAR_DATA *ch, char * argument )
    sprintf( buf, "shelp_%s", skill_table[sn].name );
    
    /* Search help texts for 'shelp_<name>' as keyword.... */
-   for ( pHelp = first_help; pHelp != NULL; pHelp = pHelp->next )
+   one_argument( buf, arg );
+   for ( n = 1; ( pHelp = help_lookup( arg, MAX_LEVEL, n ) ) != NULL; n++ )
       if ( !str_cmp( buf, pHelp->keyword ) )
       {
 	 found = TRUE;
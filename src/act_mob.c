@@ -314,7 +314,7 @@ bool ready_heal_room ( CHAR_DATA *ch )
    if (  ( !IS_SET( ch->in_room->affected_by, ROOM_BV_HEAL_REGEN ) )
       && ( ch->hit < ch->max_hit * 75/100 )  )
    {
-      if (  ch->mana >= mana_cost( ch, skill_lookup ( "healing light" ) )  )
+      if (  ch->mana >= mana_cost( ch, gsn_healing_light )  )
       {
         ready = FALSE;
         do_cast ( ch, "'healing light'" );
@@ -325,7 +325,7 @@ bool ready_heal_room ( CHAR_DATA *ch )
    if (  ( !IS_SET( ch->in_room->affected_by, ROOM_BV_MANA_REGEN )  )
       && ( ch->mana < ch->max_mana * 75/100 )  )
    {
-      if (  ch->mana >= mana_cost( ch, skill_lookup ( "mana flare" ) )  )
+      if (  ch->mana >= mana_cost( ch, gsn_mana_flare )  )
       {
         ready = FALSE;
         do_cast ( ch, "'mana flare'" );
@@ -387,9 +387,9 @@ void need_to_stand ( CHAR_DATA *ch )
    /* Do you need heal? if so, can you heal? */
    if (  ch->hit < ch->max_hit * 85/100  )
    {
-      if (  ( ch->mana >= mana_cost ( ch, skill_lookup ( "heal" ) ) )
-	 || ( ch->mana >= mana_cost ( ch, skill_lookup ( "cure critical" ) ) )
-	 || ( ch->mana >= mana_cost ( ch, skill_lookup ( "cure serious" ) ) )  ) 
+      if (  ( ch->mana >= mana_cost ( ch, gsn_heal ) )
+	 || ( ch->mana >= mana_cost ( ch, gsn_cure_critical ) )
+	 || ( ch->mana >= mana_cost ( ch, gsn_cure_serious ) )  ) 
       {
         get_up ( ch, current_state );
         return;
@@ -445,11 +445,11 @@ void mob_regen_check ( CHAR_DATA *ch, CHAR_DATA *target, bool need_flee )
    if (  target == NULL  )
       target = ch;
 
-   if (  ch->mana >= mana_cost ( ch, skill_lookup("heal") )  )
+   if (  ch->mana >= mana_cost ( ch, gsn_heal )  )
       sprintf ( buf, "'heal' %s", target->name );
-   else if (  ch->mana >= mana_cost ( ch, skill_lookup("cure critical") )  )  
+   else if (  ch->mana >= mana_cost ( ch, gsn_cure_critical )  )  
       sprintf ( buf, "'cure critical' %s", target->name );
-   else if (  ch->mana >= mana_cost ( ch, skill_lookup("cure serious") )  )
+   else if (  ch->mana >= mana_cost ( ch, gsn_cure_serious )  )
       sprintf ( buf, "'cure serious' %s", target->name );
    else if (  need_flee == TRUE  )
    {
@@ -537,21 +537,21 @@ void power_up_mob ( CHAR_DATA *ch )
       
       if (  num_percent > 75  )
       {
-	 if ( ch->mana >= mana_cost( ch, skill_lookup( "cloak:flaming")) )
+	 if ( ch->mana >= mana_cost( ch, gsn_cloak_flaming) )
 	    do_cast ( ch, "'cloak:flaming'" );
 	 return;
       }
 
       if (  num_percent > 50  )
       {
-	 if ( ch->mana >= mana_cost( ch, skill_lookup( "cloak:reflection")) )
+	 if ( ch->mana >= mana_cost( ch, gsn_cloak_reflection) )
 	    do_cast ( ch, "cloak:reflection" );
 	 return;
       }
  
       if (  num_percent > 25  )
       {
-	 if ( ch->mana >= mana_cost( ch, skill_lookup( "cloak:absorption")) )
+	 if ( ch->mana >= mana_cost( ch, gsn_cloak_absorption) )
 	    do_cast ( ch, "cloak:absorption" );
 	 return;
       }
@@ -560,16 +560,16 @@ void power_up_mob ( CHAR_DATA *ch )
    /* usually i only have mobs do one thing per round but what they hell 
     * let the kids have their fun :) */
    if (  !IS_AFFECTED( ch, AFF_SANCTUARY )  )
-      if (  ch->mana >= mana_cost( ch, skill_lookup( "sanctuary" ))  )
+      if (  ch->mana >= mana_cost( ch, gsn_sanctuary)  )
          do_cast ( ch, "sanctuary" );
    if (  !IS_AFFECTED( ch, AFF_PROTECT )  )
-      if (  ch->mana >= mana_cost( ch, skill_lookup( "protection" ))  )
+      if (  ch->mana >= mana_cost( ch, gsn_protection)  )
 	 do_cast ( ch, "protection" );
-   if (  !IS_AFFECTED( ch, skill_lookup( "bless" ) )  )
-      if (  ch->mana >= mana_cost( ch, skill_lookup( "bless" ))  )
+   if (  !IS_AFFECTED( ch, gsn_bless )  )
+      if (  ch->mana >= mana_cost( ch, gsn_bless)  )
 	 do_cast ( ch, "bless" );
-   if ( !IS_AFFECTED( ch, skill_lookup( "stone skin" ) )  )
-      if (  ch->mana >= mana_cost( ch, skill_lookup( "stone skin" ))  )
+   if ( !IS_AFFECTED( ch, gsn_stone_skin )  )
+      if (  ch->mana >= mana_cost( ch, gsn_stone_skin)  )
 	 do_cast ( ch, "stone" );
    return;
 }        
@@ -588,7 +588,7 @@ void mob_is_standing ( CHAR_DATA *ch )
    /* get a light source */
    if ( ch->in_room->light <= 0 )
    {
-      if (  ch->mana >= mana_cost( ch, skill_lookup("continual light") )  )
+      if (  ch->mana >= mana_cost( ch, gsn_continual_light )  )
       {
          do_cast ( ch, "'continual light'" );
          do_get ( ch, "all" );
@@ -601,10 +601,10 @@ void mob_is_standing ( CHAR_DATA *ch )
       || ( IS_AFFECTED( ch, AFF_BLIND ) )  )
    {
       if (  IS_AFFECTED( ch, AFF_POISON )  )
-	 if (  ch->mana >= mana_cost( ch, skill_lookup( "cure poison" ))  )
+	 if (  ch->mana >= mana_cost( ch, gsn_cure_poison)  )
 	    do_cast ( ch, "'cure poison'" );
       if (  IS_AFFECTED( ch, AFF_BLIND )  )
-	 if ( ch->mana >= mana_cost( ch, skill_lookup( "cure blindness")) )
+	 if ( ch->mana >= mana_cost( ch, gsn_cure_blindness) )
 	    do_cast ( ch, "'cure blindness'" );
       return;
    }
@@ -678,9 +678,9 @@ void mob_is_standing ( CHAR_DATA *ch )
    /* do you need to heal? */
    if (  ch->hit < ch->max_hit * 85/100  )
    {
-      if (  ( ch->mana >= mana_cost ( ch, skill_lookup ( "heal" ) ) )
-	 || ( ch->mana >= mana_cost ( ch, skill_lookup ( "cure critical" ) ) )
-	 || ( ch->mana >= mana_cost ( ch, skill_lookup ( "cure serious" ) ) )  )
+      if (  ( ch->mana >= mana_cost ( ch, gsn_heal ) )
+	 || ( ch->mana >= mana_cost ( ch, gsn_cure_critical ) )
+	 || ( ch->mana >= mana_cost ( ch, gsn_cure_serious ) )  )
       
 	 mob_regen_check ( ch, NULL, FALSE );
 
@@ -931,14 +931,14 @@ void    select_target( CHAR_DATA *ch )
         {
           if (  ( is_same_group ( ch, vch ) ) == TRUE  )
           {
-	          if (  vch->mana < mana_cost ( vch, skill_lookup ( "ethereal travel") )  )
+	          if (  vch->mana < mana_cost ( vch, gsn_ethereal_travel )  )
             {
               return;
             }
           }
         }
       }
-      if (  ch->mana < mana_cost ( ch, skill_lookup( "ethereal travel" ) )  )
+      if (  ch->mana < mana_cost ( ch, gsn_ethereal_travel )  )
         return;
 
       do_say( ch, "This place is boring! I am gonna go somewhere else!" );
@@ -160,7 +160,7 @@ void move_char( CHAR_DATA *ch, int door )
     {
       if ( IS_NPC( ch ) && IS_SET( ch->act, ACT_INTELLIGENT )  )
       {
-        if ( ch->mana > mana_cost( ch, skill_lookup( "room dispel" ) )  )
+        if ( ch->mana > mana_cost( ch, gsn_room_dispel )  )
           do_cast( ch, "room dispel" );
       }
       else
@@ -173,7 +173,7 @@ void move_char( CHAR_DATA *ch, int door )
     {
       if ( IS_NPC( ch ) && IS_SET( ch->act, ACT_INTELLIGENT )  )
       {
-        if ( ch->mana > mana_cost( ch, skill_lookup( "room dispel" ) )  )
+        if ( ch->mana > mana_cost( ch, gsn_room_dispel )  )
           do_cast( ch, "room dispel" );
       }
       else
@@ -253,7 +253,7 @@ void move_char( CHAR_DATA *ch, int door )
   /*  Int Mobs need to be able to handle climbs  */
     if ( IS_SET( pexit->exit_info, EX_CLIMB ) && IS_NPC(ch) && !IS_AFFECTED( ch, AFF_FLYING )  )
     {
-      if  ( ch->mana > mana_cost( ch, skill_lookup( "fly" ) )   )
+      if  ( ch->mana > mana_cost( ch, gsn_fly )   )
       {
         do_cast( ch, "fly" );
       }
@@ -355,7 +355,7 @@ void move_char( CHAR_DATA *ch, int door )
             
          if (  ( IS_NPC( ch ) )
             && ( IS_SET( ch->act, ACT_INTELLIGENT ) )
-            && ( ch->mana > mana_cost( ch, skill_lookup( "fly" ) )  )     )
+            && ( ch->mana > mana_cost( ch, gsn_fly )  )     )
          {
            do_cast( ch, "fly" );
          }
@@ -399,7 +399,7 @@ void move_char( CHAR_DATA *ch, int door )
        {
          if (  ( IS_NPC( ch ) )
             && ( IS_SET( ch->act, ACT_INTELLIGENT ) )
-            && ( ch->mana > mana_cost( ch, skill_lookup( "fly" ) )  )     )
+            && ( ch->mana > mana_cost( ch, gsn_fly )  )     )
          {
            do_cast( ch, "fly" );
          }
@@ -673,6 +673,7 @@ void do_open( CHAR_DATA *ch, char *argument )
 	    { send_to_char( "It's locked.\n\r",            ch ); return; }
 
 	REMOVE_BIT(pexit->exit_info, EX_CLOSED);
+	hunt_doors_changed( );
 	act( "$n opens the $d.", ch, NULL, pexit->keyword, TO_ROOM );
 	send_to_char( "Ok.\n\r", ch );
 
@@ -736,6 +737,7 @@ void do_close( CHAR_DATA *ch, char *argument )
 	    { send_to_char( "It's already closed.\n\r",    ch ); return; }
 
 	SET_BIT(pexit->exit_info, EX_CLOSED);
+	hunt_doors_changed( );
 	act( "$n closes the $d.", ch, NULL, pexit->keyword, TO_ROOM );
 	send_to_char( "Ok.\n\r", ch );
 
@@ -824,6 +826,7 @@ void do_lock( CHAR_DATA *ch, char *argument )
 	    { send_to_char( "It's already locked.\n\r",    ch ); return; }
 
 	SET_BIT(pexit->exit_info, EX_LOCKED);
+	hunt_doors_changed( );
 	send_to_char( "*Click*\n\r", ch );
 	act( "$n locks the $d.", ch, NULL, pexit->keyword, TO_ROOM );
 
@@ -893,6 +896,7 @@ void do_unlock( CHAR_DATA *ch, char *argument )
 	    { send_to_char( "It's already unlocked.\n\r",  ch ); return; }
 
 	REMOVE_BIT(pexit->exit_info, EX_LOCKED);
+	hunt_doors_changed( );
 	send_to_char( "*Click*\n\r", ch );
 	act( "$n unlocks the $d.", ch, NULL, pexit->keyword, TO_ROOM );
 
@@ -982,6 +986,7 @@ void do_pick( CHAR_DATA *ch, char *argument )
 	    { send_to_char( "You failed.\n\r",             ch ); return; }
 
 	REMOVE_BIT(pexit->exit_info, EX_LOCKED);
+	hunt_doors_changed( );
 	send_to_char( "*Click*\n\r", ch );
 	act( "$n picks the $d.", ch, NULL, pexit->keyword, TO_ROOM );
 
@@ -1733,6 +1738,7 @@ void do_smash( CHAR_DATA *ch, char *argument )
            joke = TRUE;
            
 	REMOVE_BIT(pexit->exit_info, EX_CLOSED);
+	hunt_doors_changed( );
 	act( "$n smashes opens the $d.", ch, NULL, pexit->keyword, TO_ROOM );
 	act( "You smash open the $d.", ch, NULL, pexit->keyword, TO_CHAR );
 
@@ -1840,7 +1846,7 @@ void do_scan( CHAR_DATA *ch, char *argument )
 
 	  }
               if (  ( pexit->to_room->affected_by != 0 ) 
-                 && ( ( is_affected( ch, skill_lookup( "detect magic" ) ) )  
+                 && ( ( is_affected( ch, gsn_detect_magic ) )  
                       || ( item_has_apply( ch, ITEM_APPLY_DET_MAG ) )  ) )
               {
                 sprintf( buf, "The room %s has a @@rMagical@@N Affect!!!\n\r", dir_name[door] );
@@ -3026,8 +3026,7 @@ void do_buy( CHAR_DATA *ch, char *argument )
       if ( arg[0] != '\0' )
       {
 	      sprintf( buf, "%s %s", pet->name, arg );
-	      free_string( pet->name );
-	      pet->name = str_dup( buf );
+	      char_rename( pet, buf );
       }
 
       sprintf( buf, "%sA neck tag says 'I belong to %s'.\n\r",
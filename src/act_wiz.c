@@ -335,6 +335,8 @@ void do_pardon( CHAR_DATA *ch, char *argument )
 void do_echo( CHAR_DATA *ch, char *argument )
 {
     DESCRIPTOR_DATA *d;
+    char buf[MAX_STRING_LENGTH];
+    OUT_CAST cast;
     
     if ( argument[0] == '\0' )
     {
@@ -342,14 +344,14 @@ void do_echo( CHAR_DATA *ch, char *argument )
 	return;
     }
 
+    sprintf( buf, "%s@@g\n\r", argument );
+    cast_init( &cast, buf );
     for ( d = first_desc; d; d = d->next )
     {
 	if ( d->connected == CON_PLAYING )
-	{
-	    send_to_char( argument, d->character );
-	    send_to_char( "@@g\n\r",   d->character );
-	}
+	    cast_to( &cast, d );
     }
+    cast_done( &cast );
 
     return;
 }
@@ -2734,6 +2736,7 @@ void do_mset( CHAR_DATA *ch, char *argument )
        send_to_char("Adding intelligence.\n\r",ch);
        SET_BIT(victim->act,ACT_INTELLIGENT);
       }
+      room_kind_update( victim );
     }
     
      
@@ -3180,8 +3183,7 @@ void do_mset( CHAR_DATA *ch, char *argument )
 	    return;
 	}
 
-	free_string( victim->name );
-	victim->name = str_dup( arg3 );
+	char_rename( victim, arg3 );
 	return;
     }
 
@@ -3616,9 +3618,9 @@ void do_users( CHAR_DATA *ch, char *argument )
     buf[0]      = '\0';
     buf2[0]     = '\0';
 
-    send_to_char( "\n\r Desc.  Connection State.   Player Name.     Login Site.", ch );
+    send_to_char( "\n\r Desc.  Connection State.   Player Name.     Login Site.                Queued   Peak Drop", ch );
     if ( get_trust( ch ) == 85 )
-       send_to_char("                 Port.\n\r", ch );
+       send_to_char("  Port.\n\r", ch );
     else
        send_to_char( "\n\r", ch );
     
@@ -3650,6 +3652,8 @@ void do_users( CHAR_DATA *ch, char *argument )
 		  sprintf( buf3, "%s", "Get New Race    "); break;
 	       case CON_READ_MOTD:           
 		  sprintf( buf3, "%s", "Reading MOTD    "); break;
+	       case CON_RESOLVING:
+		  sprintf( buf3, "%s", "Resolving       "); break;
 	       default:                      
 		  sprintf( buf3, "%s", "Unknown...      "); break;
 	    }
@@ -3662,6 +3666,11 @@ void do_users( CHAR_DATA *ch, char *argument )
 		d->character ? d->character->name : "(none)",
 		d->host
 		);
+	    sprintf( buf + strlen(buf), " %5dk%c%5dk %4d",
+		OUT_PENDING( d ) / 1024,
+		IS_SET( d->flags, DESC_FLAG_OUTFLOODED ) ? '!' : ' ',
+		d->outpeak / 1024,
+		d->outdropped );
 	   if ( get_trust( ch ) == 85 )
 	      sprintf( buf + strlen(buf), "  %5d\n\r", d->remote_port );
 	   else
@@ -4410,7 +4419,7 @@ void do_setclass( CHAR_DATA *ch, char *argument )
         {
 	    victim->pcdata->learned[sn] = 0;
         }
-         victim->pcdata->learned[skill_lookup( "feed" )] = 90;
+         victim->pcdata->learned[gsn_feed] = 90;
       }
         
 	if ( remort )
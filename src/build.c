@@ -257,8 +257,6 @@ extern OBJ_INDEX_DATA *        obj_index_hash          [MAX_KEY_HASH];
 extern ROOM_INDEX_DATA *       room_index_hash         [MAX_KEY_HASH];
 extern char *                  string_hash             [MAX_KEY_HASH];
 
-extern char *                  string_space;
-extern char *                  top_string;
 extern char                    str_empty       [1];
 
 extern int                     top_affect;
@@ -2247,6 +2245,7 @@ void build_setroom( CHAR_DATA *ch, char * argument)
 	}
 
 	pExit=location->exit[door];
+	hunt_graph_changed( );
 
 	if (! str_cmp(arg3,"clear"))
 	{
@@ -3038,6 +3037,7 @@ void build_dig( CHAR_DATA *ch, char *argument )
     pExit->key=-1;
     top_exit++;
     pCurRoom->exit[dir]=pExit;
+    hunt_graph_changed( );
 
     if ( str_cmp(arg3,"onesided"))           /* If NOT onesided */
     {
@@ -3959,6 +3959,7 @@ void build_delroom( CHAR_DATA *ch, char *argument )
     }
     PUT_FREE( pRoomIndex->treasure, money_type_free );
     PUT_FREE(pRoomIndex, rid_free);
+    hunt_graph_changed( );
     
     top_room--;   
  
@@ -4424,8 +4425,7 @@ void build_strdup( char * * dest, char * src, bool freesrc, CHAR_DATA * ch)
 
     /* spec- call str_dup to do most of the work */
 
-    /* SSM still uses a single string block, so we're relatively safe here */
-    if (src >= string_space && src < top_string)
+    if (ssm_owns(src))
     {
      *dest=str_dup(src);
      return;
@@ -5411,14 +5411,11 @@ void build_findhelp( CHAR_DATA *ch, char *argument )
       return;
    }
    
-   for ( pHelp = first_help; pHelp != NULL; pHelp = pHelp->next )
+   while ( ( pHelp = help_lookup( arg, MAX_LEVEL, cnt + 1 ) ) != NULL )
    {
-      if ( is_name( arg, pHelp->keyword ) )
-      {
-         cnt++;
-         sprintf( buf, "[%2d] <%s> \n\r%1.100s\n\r", cnt, pHelp->keyword, pHelp->text );
-         send_to_char( buf, ch );
-      }
+      cnt++;
+      sprintf( buf, "[%2d] <%s> \n\r%1.100s\n\r", cnt, pHelp->keyword, pHelp->text );
+      send_to_char( buf, ch );
    }
    if ( cnt == 0 )
       send_to_char( "Couldn't find that keyword.\n\r", ch );
@@ -5435,10 +5432,8 @@ void build_helpedit( CHAR_DATA *ch, char *argument )
    BUILD_DATA_LIST *plist;
    char arg[MAX_STRING_LENGTH];
    int number;
-   int count;
    
    number = number_argument( argument, arg );
-   count =0;
    
    if ( arg[0] == '\0' )
    {
@@ -5448,10 +5443,7 @@ void build_helpedit( CHAR_DATA *ch, char *argument )
    
    /** Now try and find the keyword **/
    
-   for ( pHelp = first_help; pHelp != NULL; pHelp = pHelp->next )
-      if ( is_name( arg, pHelp->keyword )
-      && ( ++count == number ) )
-         break; 
+   pHelp = help_lookup( arg, MAX_LEVEL, number );
 
    if ( pHelp == NULL )
    {
@@ -5507,6 +5499,7 @@ void build_addhelp( CHAR_DATA *ch, char *argument )
 	pHelp->text     = str_dup( "NEW HELP.  DELETE THIS LINE FIRST!" ); 
 
 	LINK(pHelp, first_help, last_help, next, prev);
+	help_index_add( pHelp );
 /* MAG Mod */
 	GET_FREE(pList, build_free);
 	pList->data     = pHelp;
@@ -60,6 +60,7 @@
 #include "imc.h"
 #include "icec.h"
 #include "cursor.h"
+#include "netpoll.h"
 
 
 /*
@@ -111,6 +112,7 @@ const   char    go_ahead_str    [] = { '\0' };
 #include <netdb.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <arpa/telnet.h>
 const   char    echo_off_str    [] = { IAC, WILL, TELOPT_ECHO, '\0' };
 const   char    echo_on_str     [] = { IAC, WONT, TELOPT_ECHO, '\0' };
@@ -165,8 +167,7 @@ int     accept          args( ( int s, struct sockaddr *addr, int *addrlen ) );
 int     bind            args( ( int s, struct sockaddr *name, int namelen ) );
 */
 int     close           args( ( int fd ) );
-int     getpeername     args( ( int s, struct sockaddr *name, int *namelen ) );
-int     getsockname     args( ( int s, struct sockaddr *name, int *namelen ) );
+/* getpeername and getsockname come from <sys/socket.h>, with socklen_t */
 int     gettimeofday    args( ( struct timeval *tp, struct timezone *tzp ) );
 int     listen          args( ( int s, int backlog ) );
 /*int     read            args( ( int fd, char *buf, int nbyte ) );*/
@@ -360,6 +361,11 @@ int     init_socket             args( ( int port ) );
 void    new_descriptor          args( ( int control ) );
 bool    read_from_descriptor    args( ( DESCRIPTOR_DATA *d ) );
 bool    write_to_descriptor     args( ( int desc, char *txt, int length ) );
+int     writev_nonblocking      args( ( int desc, struct iovec *iov, int niov ) );
+int     output_iov              args( ( DESCRIPTOR_DATA *d, struct iovec *iov,
+				    int *total ) );
+void    output_consume          args( ( DESCRIPTOR_DATA *d, int n ) );
+void    output_snoop            args( ( DESCRIPTOR_DATA *d, int skip ) );
 void    init_descriptor		args( ( DESCRIPTOR_DATA *dnew, int desc ) );
 #endif
 
@@ -483,12 +489,14 @@ int main( int argc, char **argv )
 /*+*/    global_port = port;
     if ( fCopyOver )
       abort_threshold = BOOT_DB_ABORT_THRESHOLD;
+    netpoll_init();   /* before boot_db, copyover_recover registers sockets */
     boot_db( fCopyOver );
 #ifndef WIN32
     init_alarm_handler();
     imc_startup( "imc/" );
     icec_init();
 #endif
+    resolve_init();
     sprintf( log_buf, "ACK! MUD is ready on port %d.", port );
     log_string( log_buf );
     game_loop_unix( control );
@@ -498,6 +506,7 @@ int main( int argc, char **argv )
     close( control );
 #if defined ( SOE ) && !defined ( SOETEST ) && !defined ( SOEBLD )
     close( control2 );
+#endif
 #endif
 
     /*
@@ -635,7 +644,7 @@ void game_loop_mac_msdos( void )
 		{
 		    if ( d->character != NULL )
 			save_char_obj( d->character );
-		    d->outtop   = 0;
+		    discard_output( d );
 		    close_socket( d );
 		    continue;
 		}
@@ -681,13 +690,13 @@ void game_loop_mac_msdos( void )
 	{
 	    d_next = d->next;
 
-	    if ( ( d->fcommand || d->outtop > 0 ) )
+	    if ( d->fcommand || HAS_OUTPUT( d ) )
 	    {
 		if ( !process_output( d, TRUE ) )
 		{
 		    if ( d->character != NULL )
 			save_char_obj( d->character );
-		    d->outtop   = 0;
+		    discard_output( d );
 		    close_socket( d );
 		}
 	    }
@@ -756,7 +765,6 @@ void reopen_socket(int sig)
 
 void game_loop_unix( int control )
 {
-    static struct timeval null_time;
     struct timeval last_time;
 
     signal( SIGPIPE, SIG_IGN );
@@ -769,17 +777,35 @@ void game_loop_unix( int control )
 
 /*+*/
 
+    /*
+     * Player sockets register themselves as they connect (or come back
+     * from a HOTreboot), so only the listeners need adding here.
+     */
+    netpoll_add( control, NULL );
+#if defined ( SOE ) && !defined ( SOETEST ) && !defined ( SOEBLD )
+    netpoll_add( control2, NULL );
+#endif
+    sprintf( log_buf, "Polling descriptors with %s.", netpoll_backend( ) );
+    log_string( log_buf );
+
     gettimeofday( &last_time, NULL );
     current_time = (time_t) last_time.tv_sec;
 
     /* Main loop */
     while ( !merc_down )
     {
+      static struct timeval null_time;
       fd_set in_set;
       fd_set out_set;
       fd_set exc_set;
       DESCRIPTOR_DATA *d;
       int maxdesc;
+      int listen_fd[MAX_LISTEN];
+      int nlisten;
+      int nready;
+      int i;
+      long long pulse_start;
+      long long phase_start;
 
 /* #if defined(MALLOC_DEBUG)
       if ( malloc_verify( ) != 1 )
@@ -794,83 +820,55 @@ void game_loop_unix( int control )
 	if (reopen_flag)
 	{
 	    log_string("SIGUSR1 received, reopening control socket");
+	    netpoll_del(control);
 	    close(control);
 	    control=init_socket(global_port);
+	    netpoll_add(control, NULL);
 	    reopen_flag=0;
 	}
 /*+*/ 
 
+	pulse_start = phase_start = current_usec( );
 
 	/*
 	 * Poll all active descriptors.
+	 * Listeners come back with no descriptor attached: accept on them,
+	 * but only once we're done with netpoll_ready, since registering
+	 * the new socket may grow it.  Everybody else just gets told what
+	 * they're ready for.
 	 */
-	FD_ZERO( &in_set  );
-	FD_ZERO( &out_set );
-	FD_ZERO( &exc_set );
-	FD_SET( control, &in_set );
-#if defined ( SOE ) && !defined ( SOETEST ) && !defined ( SOEBLD )
-	FD_SET( control2, &in_set );
-#endif
-        maxdesc = UMAX( control, control2 );
-#else
-	maxdesc = control;
-#endif
-	for ( d = first_desc; d; d = d->next )
+	nready = netpoll_wait( 0 );
+	nlisten = 0;
+	for ( i = 0; i < nready; i++ )
 	{
-	    if ((d->flags && DESC_FLAG_PASSTHROUGH)==0)
+	    if ( ( d = netpoll_ready[i].d ) == NULL )
 	    {
-	     maxdesc = UMAX( maxdesc, d->descriptor );
-	     FD_SET( d->descriptor, &in_set  );
-	     FD_SET( d->descriptor, &out_set );
-	     FD_SET( d->descriptor, &exc_set );
+		if ( ( netpoll_ready[i].events & NP_READ )
+		&&   nlisten < MAX_LISTEN )
+		    listen_fd[nlisten++] = netpoll_ready[i].fd;
+		continue;
 	    }
-	    else
-	    {
-	     /* Check to see if child process has terminated */
-	     if ( waitpid(d->childpid,NULL,WNOHANG) != 0 )
-	     {
-	      /* Terminated or error */
-	      d->childpid=0;
-	      REMOVE_BIT(d->flags,DESC_FLAG_PASSTHROUGH);
-	     }
-	    } 
-	}
-
-	/* IMC */
-	maxdesc=imc_fill_fdsets(maxdesc, &in_set, &out_set, &exc_set);
- 
-	if ( select( maxdesc+1, &in_set, &out_set, &exc_set, &null_time ) < 0 )
-	{
-	    perror( "Game_loop: select: poll" );
-	    exit( 1 );
+	    d->ioready |= netpoll_ready[i].events;
 	}
+	for ( i = 0; i < nlisten; i++ )
+	    new_descriptor( listen_fd[i] );
 
-	/*
-	 * New connection?
-	 */
-
-
-	if ( FD_ISSET( control, &in_set ) )
- 	    new_descriptor( control );
-#if defined ( SOE ) && !defined ( SOETEST ) && !defined ( SOEBLD )
-	if ( FD_ISSET( control2, &in_set ) )
- 	    new_descriptor( control2 );
-#endif
+	/* Hostnames the resolver thread has come up with */
+	resolve_update( );
 
 
 	/*
-	 * Kick out the freaky folks.
+	 * Kick out the freaky folks.  Go by the descriptor list rather than
+	 * the edges: resolve_update may have closed some of them already.
 	 */
 	for ( d = first_desc; d != NULL; d = d_next )
 	{
-	    d_next = d->next;   
-	    if ( FD_ISSET( d->descriptor, &exc_set ) )
+	    d_next = d->next;
+	    if ( IS_SET( d->ioready, NP_EXCEPT ) )
 	    {
-		FD_CLR( d->descriptor, &in_set  );
-		FD_CLR( d->descriptor, &out_set );
 		if ( d->character )
 		    save_char_obj( d->character );
-		d->outtop       = 0;
+		discard_output( d );
 		close_socket( d );
 	    }
 	}
@@ -884,16 +882,27 @@ void game_loop_unix( int control )
 	    d_next      = d->next;
 	    d->fcommand = FALSE;
 
-	    if ( FD_ISSET( d->descriptor, &in_set ) )
+	    if ( IS_SET( d->flags, DESC_FLAG_PASSTHROUGH ) )
+	    {
+		/* Check to see if child process has terminated */
+		if ( waitpid(d->childpid,NULL,WNOHANG) != 0 )
+		{
+		    /* Terminated or error */
+		    d->childpid=0;
+		    REMOVE_BIT(d->flags,DESC_FLAG_PASSTHROUGH);
+		}
+		continue;
+	    }
+
+	    if ( IS_SET( d->ioready, NP_READ ) )
 	    {
 		if ( d->character != NULL )
 		    d->character->timer = 0;
 		if ( !read_from_descriptor( d ) )
 		{
-		    FD_CLR( d->descriptor, &out_set );
 		    if ( d->character != NULL )
 			save_char_obj( d->character );
-		    d->outtop   = 0;
+		    discard_output( d );
 		    close_socket( d );
 		    continue;
 		}
@@ -905,6 +914,10 @@ void game_loop_unix( int control )
 		continue;
 	    }
 
+	    /* Hold their input until we know where they're from */
+	    if ( d->connected == CON_RESOLVING )
+		continue;
+
 	    read_from_buffer( d );
 	    if ( d->incomm[0] != '\0' )
 	    {
@@ -923,23 +936,46 @@ void game_loop_unix( int control )
 		d->incomm[0]    = '\0';
 	    }
 	}
+	pstat_record( PSTAT_INPUT, phase_start );
 
-	/* let IMC run */
+	/* let IMC run; it keeps its own sockets, so it gets its own select */
+	phase_start = current_usec( );
+	FD_ZERO( &in_set  );
+	FD_ZERO( &out_set );
+	FD_ZERO( &exc_set );
+	maxdesc=imc_fill_fdsets(-1, &in_set, &out_set, &exc_set);
+	if ( maxdesc >= 0
+	&&   select( maxdesc+1, &in_set, &out_set, &exc_set, &null_time ) < 0 )
+	{
+	    perror( "Game_loop: select: imc" );
+	    FD_ZERO( &in_set  );
+	    FD_ZERO( &out_set );
+	    FD_ZERO( &exc_set );
+	}
 	imc_idle_select(&in_set, &out_set, &exc_set, current_time);
+	pstat_record( PSTAT_IMC, phase_start );
 
 	/*
 	 * Autonomous game motion.
 	 */
+	phase_start = current_usec( );
 	update_handler( );
+	pstat_record( PSTAT_UPDATE, phase_start );
   waitpid( 0, 0, WNOHANG );
 
 
 	/*
 	 * Output.
+	 * Sockets that wouldn't take everything last time are left alone
+	 * until the poller says they've drained.
 	 */
+	phase_start = current_usec( );
 	for ( d = first_desc; d != NULL; d = d_next )
 	{
+	    int ioready = d->ioready;
+
 	    d_next = d->next;
+	    d->ioready = 0;
 
 	    /* spec: disconnect people idling on login */
 	    if (d->connected<0 && d->timeout < current_time)
@@ -950,41 +986,52 @@ void game_loop_unix( int control )
 	      continue;
 	    }
 
-	    if ( ( d->fcommand || d->outtop > 0 )
-	    &&   FD_ISSET(d->descriptor, &out_set) )
+	    /* give up on links that never drain, see output_level */
+	    if ( OUT_PENDING( d ) > OUT_MAX_QUEUED
+	    ||   ( IS_SET( OUT_POLICY, OUT_HANGUP )
+	      &&   IS_SET( d->flags, DESC_FLAG_OUTFLOODED )
+	      &&   current_time - d->outflood > OUT_FLOOD_TIME ) )
+	    {
+		log_f( "Output flood: closing %s@%s, %d bytes queued.",
+		  d->character != NULL ? d->character->name : "(none)",
+		  d->host, OUT_PENDING( d ) );
+		if ( d->character != NULL )
+		    save_char_obj( d->character );
+		discard_output( d );
+		close_socket( d );
+		continue;
+	    }
+
+	    if ( IS_SET( d->flags, DESC_FLAG_OUTBLOCKED )
+	    &&   !IS_SET( ioready, NP_WRITE ) )
+		continue;
+
+	    if ( d->fcommand || HAS_OUTPUT( d ) )
 	    {
 		if ( !process_output( d, TRUE ) )
 		{
 		    if ( d->character != NULL )
 			save_char_obj( d->character );
-		    d->outtop   = 0;
+		    discard_output( d );
 		    close_socket( d );
 		}
 	    }
 	}
+	pstat_record( PSTAT_OUTPUT, phase_start );
+	pstat_record( PSTAT_PULSE, pulse_start );
 
 
 	/*
 	 * Synchronize to a clock.
-	 * Sleep( last_time + 1/PULSE_PER_SECOND - now ).
-	 * Careful here of signed versus unsigned arithmetic.
+	 * pulse_sleep (update.c) keeps a monotonic deadline per pulse.
 	 */
 	{
-	    struct timeval now_time;
 	    struct tm    * now_bd_time;
 	    FILE *         out_file;
-	    long secDelta;
-	    long usecDelta;
-
  	    long temp_time;
- 
- 	    
 
-
-
-	    gettimeofday( &now_time, NULL );
-/*	    now_bd_time=localtime(&(now_time.tv_sec));  */
-	    temp_time=(time_t)now_time.tv_sec;
+	    gettimeofday( &last_time, NULL );
+	    temp_time=(time_t)last_time.tv_sec;
 	    now_bd_time=localtime(&temp_time);
 	    
 	    if (now_bd_time->tm_hour != cur_hour)
@@ -995,35 +1042,9 @@ void game_loop_unix( int control )
 	     fclose(out_file);
 	     max_players=cur_players;
 	    }
-	    
-	    usecDelta   = ((int) last_time.tv_usec) - ((int) now_time.tv_usec)
-			+ 1000000 / PULSE_PER_SECOND;
-	    secDelta    = ((int) last_time.tv_sec ) - ((int) now_time.tv_sec );
-	    while ( usecDelta < 0 )
-	    {
-		usecDelta += 1000000;
-		secDelta  -= 1;
-	    }
-
-	    while ( usecDelta >= 1000000 )
-	    {
-		usecDelta -= 1000000;
-		secDelta  += 1;
-	    }
-
-	    if ( secDelta > 0 || ( secDelta == 0 && usecDelta > 0 ) )
-	    {
-		struct timeval stall_time;
 
-		stall_time.tv_usec = usecDelta;
-		stall_time.tv_sec  = secDelta;
-		if ( select( 0, NULL, NULL, NULL, &stall_time ) < 0 &&
-		     errno != EINTR)
-		{
-		    perror( "Game_loop: select: stall" );
-		    exit( 1 );
-		}
-	    }
+	    ssm_sweep( pulse_idle( ) );
+	    pulse_sleep( );
 	}
 
 
@@ -1067,7 +1088,7 @@ void new_descriptor( int control )
     struct sockaddr_in sock;
 /*    struct hostent *from;  unused??? */
     int desc;
-    int size;
+    socklen_t size;
 
     size = sizeof(sock);
     getsockname( control, (struct sockaddr *) &sock, &size );
@@ -1128,47 +1149,23 @@ void new_descriptor( int control )
 	monitor_chan( log_buf, MONITOR_CONNECT );
 	
 	dnew->remote_port = ntohs( sock.sin_port );
+	strcpy( dnew->ip, buf );
 	
-	/* From unused to prevent possible ns lockup 
-	from = gethostbyaddr( (char*) &sock.sin_addr,
-	    sizeof(sock.sin_addr), AF_INET ); */
-	
+	/* The site name is looked up off the game loop, see resolve.c */
 	dnew->host = str_dup( buf );
     }
 	
     /*
-     * Swiftest: I added the following to ban sites.  I don't
-     * endorse banning of sites, but Copper has few descriptors now
-     * and some people from certain sites keep abusing access by
-     * using automated 'autodialers' and leaving connections hanging.
-     *
-     * Furey: added suffix check by request of Nickel of HiddenWorlds.
-     *
-     * Stephen: As we use IP address now, want to use prefix check,
-     * so we can ban whole domains....
+     * Init descriptor data.
      */
- /* MOVED TO LOWER FOR NEWBIEBAN     
-    
-    for ( pban = first_ban; pban != NULL; pban = pban->next )
+    if ( !netpoll_add( desc, dnew ) )
     {
-	if ( !str_prefix( pban->name, dnew->host ) && !( pban->newbie ) )
-	{
-	    char buf[MAX_STRING_LENGTH];
-	    sprintf( buf, "Denying access to banned site %s", dnew->host );
-	    monitor_chan( buf, MONITOR_CONNECT );
-	    write_to_descriptor( desc,
-		"Your site has been banned from this Mud.  BYE BYE!\n\r", 0 );
-	    free_desc(dnew);
-	    PUT_FREE(dnew, desc_free);
-	    return;
-	}
+	write_to_descriptor( desc,
+	    "Sorry, no room for more connections right now.\n\r", 0 );
+	free_desc(dnew);
+	PUT_FREE(dnew, desc_free);
+	return;
     }
-
-
-*/
-    /*
-     * Init descriptor data.
-     */
     LINK(dnew, first_desc, last_desc, next, prev);
 
     /* spec: set initial login timeout */
@@ -1199,11 +1196,77 @@ void new_descriptor( int control )
     if (cur_players > max_players)
      max_players=cur_players;
 
+    /*
+     * Look up the site name.  If it isn't cached the descriptor waits in
+     * CON_RESOLVING, and resolve_update calls host_resolved later.
+     */
+    if ( resolve_host( dnew ) )
+	host_resolved( dnew );
+
     return;
 }
 #endif
 
 
+/*
+ * The site is known (or we've given up on the nameserver): check the
+ * site bans and let them carry on logging in.
+ */
+void host_resolved( DESCRIPTOR_DATA *d )
+{
+    d->connected = CON_GET_NAME;
+
+    if ( strcmp( d->host, d->ip ) )
+    {
+	sprintf( log_buf, "Site for %s is %s.", d->ip, d->host );
+	monitor_chan( log_buf, MONITOR_CONNECT );
+    }
+
+    if ( check_ban( d, FALSE ) != NULL )
+    {
+	sprintf( log_buf, "Denying access to banned site %s", d->host );
+	monitor_chan( log_buf, MONITOR_CONNECT );
+	write_to_descriptor( d->descriptor,
+	    "Your site has been banned from this Mud.  BYE BYE!\n\r", 0 );
+	discard_output( d );
+	d->connected = CON_QUITTING;
+	close_socket( d );
+    }
+    return;
+}
+
+
+/*
+ * Swiftest: I added the following to ban sites.  I don't
+ * endorse banning of sites, but Copper has few descriptors now
+ * and some people from certain sites keep abusing access by
+ * using automated 'autodialers' and leaving connections hanging.
+ *
+ * Furey: added suffix check by request of Nickel of HiddenWorlds.
+ *
+ * Stephen: As we use IP address now, want to use prefix check,
+ * so we can ban whole domains....
+ *
+ * Bans are a prefix of the IP address, or a suffix of the site name
+ * now that we look names up again.  Newbie bans only count if fNewbie.
+ */
+BAN_DATA *check_ban( DESCRIPTOR_DATA *d, bool fNewbie )
+{
+    BAN_DATA *pban;
+
+    for ( pban = first_ban; pban != NULL; pban = pban->next )
+    {
+	if ( pban->newbie && !fNewbie )
+	    continue;
+	if ( !str_prefix( pban->name, d->ip )
+	||   !str_prefix( pban->name, d->host )
+	||   ( strcmp( d->host, d->ip ) && !str_suffix( pban->name, d->host ) ) )
+	    return pban;
+    }
+    return NULL;
+}
+
+
  void init_descriptor (DESCRIPTOR_DATA *dnew, int desc)
 {
 	static DESCRIPTOR_DATA d_zero;
@@ -1223,9 +1286,11 @@ void close_socket( DESCRIPTOR_DATA *dclose )
 {
     CHAR_DATA *ch;
 
-    if ( dclose->outtop > 0 )
+    if ( HAS_OUTPUT( dclose ) )
 	process_output( dclose, FALSE );
 
+    resolve_forget( dclose );
+
     if ( dclose->snoop_by != NULL )
     {
 	write_to_buffer( dclose->snoop_by,
@@ -1277,8 +1342,10 @@ void close_socket( DESCRIPTOR_DATA *dclose )
 	d_next = d_next->next;   
 
     UNLINK(dclose, first_desc, last_desc, next, prev);
+    netpoll_del( dclose->descriptor );
     close( dclose->descriptor );
     free_string( dclose->host );
+    discard_output( dclose );
     if ( dclose->outbuf )
       dispose(dclose->outbuf, dclose->outsize);
     if ( dclose->showstr_head )
@@ -1476,13 +1543,25 @@ void read_from_buffer( DESCRIPTOR_DATA *d )
 bool process_output( DESCRIPTOR_DATA *d, bool fPrompt )
 {
     extern bool merc_down;
+    struct iovec iov[OUT_IOV];
+    int niov;
+    int total;
+    int nWrite;
 
     /*
      * Bust a prompt.
+     * Not again for output that's only still here because the socket
+     * wouldn't take it last time, and while the socket is full just
+     * the one when it drains.
      */
-    if ( fPrompt && !merc_down && d->connected == CON_PLAYING )
+    if ( fPrompt && !merc_down && d->connected == CON_PLAYING
+    &&   ( d->fcommand || OUT_PENDING( d ) > d->outflush
+        || IS_SET( d->flags, DESC_FLAG_PROMPTDUE ) ) )
     {
-        if ( d->showstr_point )
+        if ( IS_SET( OUT_POLICY, OUT_COALESCE )
+        &&   IS_SET( d->flags, DESC_FLAG_OUTBLOCKED ) )
+            SET_BIT( d->flags, DESC_FLAG_PROMPTDUE );
+        else if ( d->showstr_point )
 	        write_to_buffer( d,
             "[Please type (c)ontinue, (r)efresh, (b)ack, (h)elp, (q)uit, or RETURN]:  ", 0 );
 	    else
@@ -1498,11 +1577,13 @@ bool process_output( DESCRIPTOR_DATA *d, bool fPrompt )
 	        if ( IS_SET(ch->config, CONFIG_TELNET_GA) )
 		        write_to_buffer( d, go_ahead_str, 0 );
         }
+        if ( !IS_SET( d->flags, DESC_FLAG_OUTBLOCKED ) )
+            REMOVE_BIT( d->flags, DESC_FLAG_PROMPTDUE );
     }
     /*
      * Short-circuit if nothing to write.
      */
-        if ( d->outtop == 0 )
+        if ( !HAS_OUTPUT( d ) )
 	        return TRUE;
     /*
      * Snoop-o-rama.
@@ -1515,22 +1596,46 @@ bool process_output( DESCRIPTOR_DATA *d, bool fPrompt )
 	        snoop_ch= d->original != NULL ? d->original : d->character;
             if (snoop_ch != NULL)
 	            sprintf( foo, "[SNOOP:%s] ", snoop_ch->name );
-	        write_to_buffer( d->snoop_by, foo, 0 );
-	        write_to_buffer( d->snoop_by, d->outbuf, d->outtop );
+            if ( OUT_PENDING( d ) > d->outflush )
+            {
+	            write_to_buffer( d->snoop_by, foo, 0 );
+	            output_snoop( d, d->outflush );
+            }
 	    }
     /*
      * OS-dependent output.
+     * Shared segments and outbuf go out together with writev.  Whatever
+     * the socket won't take now stays queued, and we ask to hear when it
+     * can take more.
      */
-        if ( !write_to_descriptor( d->descriptor, d->outbuf, d->outtop ) )
+        while ( HAS_OUTPUT( d ) )
         {
-	        d->outtop = 0;
-	        return FALSE;
+            niov = output_iov( d, iov, &total );
+            if ( ( nWrite = writev_nonblocking( d->descriptor, iov, niov ) ) < 0 )
+            {
+                discard_output( d );
+                return FALSE;
+            }
+            output_consume( d, nWrite );
+
+            if ( nWrite < total )
+            {
+                d->outflush = OUT_PENDING( d );
+                SET_BIT( d->flags, DESC_FLAG_OUTBLOCKED );
+                netpoll_want_write( d->descriptor, TRUE );
+                return TRUE;
+            }
         }
-        else
+
+        d->outflush = 0;
+        if ( IS_SET( d->flags, DESC_FLAG_OUTBLOCKED ) )
         {
-	        d->outtop = 0;
-	        return TRUE;
+            REMOVE_BIT( d->flags, DESC_FLAG_OUTBLOCKED );
+            netpoll_want_write( d->descriptor, FALSE );
+            if ( IS_SET( d->flags, DESC_FLAG_PROMPTDUE ) )
+                return process_output( d, fPrompt );
         }
+        return TRUE;
 }
 
 /*
@@ -2154,13 +2259,216 @@ void bust_a_prompt( DESCRIPTOR_DATA *d )
 }
 
 /*
- * Append onto an output buffer.
+ * Colour codes.  "@@c" expands through one of two 256-entry tables:
+ * ansi_colour for descriptors that want colour, ansi_plain (which turns
+ * every code into nothing) for those that don't.  "@@@" is a literal @
+ * in both, and letters not in ansi_table give "normal", as they always
+ * have.  Both are filled in the first time write_to_buffer runs.
  */
- 
-#define color_MARGIN 20
+static const struct ansi_type	ansi_at		= { "at", "@", -1, '@', 1 };
+static const struct ansi_type	ansi_blank	= { "blank", "", -1, '\0', 0 };
+static const struct ansi_type *	ansi_colour	[256];
+static const struct ansi_type *	ansi_plain	[256];
+static int			ansi_grow;	/* most a code can add */
+
+static void build_ansi_lookup( void )
+{
+    int c;
+    int cnt;
+
+    for ( c = 0; c < 256; c++ )
+    {
+	ansi_colour[c]	= &ansi_table[10];
+	ansi_plain[c]	= &ansi_blank;
+    }
+    /* Backwards, so the first entry with a letter wins, as before. */
+    for ( cnt = MAX_ANSI - 1; cnt >= 0; cnt-- )
+    {
+	ansi_colour[(unsigned char) ansi_table[cnt].letter] = &ansi_table[cnt];
+	ansi_grow = UMAX( ansi_grow, ansi_table[cnt].stlen - 3 );
+    }
+    ansi_colour['@']	= &ansi_at;
+    ansi_plain['@']	= &ansi_at;
+    return;
+}
+
+/*
+ * True if any byte of the word w is an '@'.
+ */
+#define WORD_ONES	( ~0UL / 255 )
+#define HAS_AT( w )	( ( ( (w) ^ ( WORD_ONES * '@' ) ) - WORD_ONES )	\
+			& ~( (w) ^ ( WORD_ONES * '@' ) ) & ( WORD_ONES * 0x80 ) )
+
+/*
+ * How one descriptor wants its colour codes expanded.
+ */
+struct colour_set
+{
+    const struct ansi_type **	lookup;
+    const struct ansi_type *	hi;		/* "@@!", NULL for the table's */
+    const struct ansi_type *	dim;		/* "@@."                       */
+};
+
+#define ANSI_FOR( cs, c )	( (c) == '!' && (cs)->hi  != NULL ? (cs)->hi	\
+				: (c) == '.' && (cs)->dim != NULL ? (cs)->dim	\
+				: (cs)->lookup[(unsigned char) (c)] )
+
+/*
+ * Pick the colour table.  Players get their own highlight and dim
+ * colours for "@@!" and "@@.".
+ */
+static void colour_set_for( DESCRIPTOR_DATA *d, struct colour_set *cs )
+{
+    CHAR_DATA *ch;
+
+    if ( ansi_colour['@'] == NULL )
+	build_ansi_lookup( );
+    ch = d->original != NULL ? d->original : d->character;
+    cs->hi = cs->dim = NULL;
+    if ( ch != NULL && !IS_SET(ch->config, CONFIG_COLOR) )
+	cs->lookup = ansi_plain;
+    else
+    {
+	cs->lookup = ansi_colour;
+	if ( ch != NULL && !IS_NPC( ch ) )  /* shouldn't happen, but...*/
+	{
+	    cs->hi  = ansi_colour[(unsigned char) ch->pcdata->hicol];
+	    cs->dim = ansi_colour[(unsigned char) ch->pcdata->dimcol];
+	}
+    }
+    return;
+}
+
+/*
+ * Exact length of txt once its colour codes are expanded.
+ */
+static int colour_length( struct colour_set *cs, const char *txt, int length )
+{
+    const char *end = txt + length;
+    const char *p;
+    int need = length;
+
+    for ( p = txt; ( p = memchr( p, '@', end - p ) ) != NULL; )
+    {
+	if ( end - p < 3 || p[1] != '@' )
+	{
+	    p++;
+	    continue;
+	}
+	need += ANSI_FOR( cs, p[2] )->stlen - 3;
+	p += 3;
+    }
+    return need;
+}
+
+/*
+ * Copy txt to dest, expanding colour codes on the way.  Plain text is
+ * scanned and copied a word at a time.  Returns the end of the copy,
+ * which is not terminated.
+ */
+static char *colour_copy( struct colour_set *cs, char *dest,
+			 const char *txt, int length )
+{
+    const struct ansi_type *ansi;
+    const char *end = txt + length;
+    const char *p;
+    unsigned long word;
+
+    for ( p = txt; p < end; )
+    {
+	/* A word at a time until one holds an @, then bytes up to it. */
+	while ( end - p >= (int) sizeof( word ) )
+	{
+	    memcpy( &word, p, sizeof( word ) );
+	    if ( HAS_AT( word ) )
+		break;
+	    memcpy( dest, &word, sizeof( word ) );
+	    dest += sizeof( word );
+	    p += sizeof( word );
+	}
+	while ( p < end && *p != '@' )
+	    *(dest++) = *(p++);
+	if ( p == end )
+	    break;
+
+	if ( end - p < 3 || p[1] != '@' )
+	{
+	    *(dest++) = *(p++);
+	    continue;
+	}
+	ansi = ANSI_FOR( cs, p[2] );
+	if ( ansi->stlen > 0 )
+	{
+	    memcpy( dest, ansi->value, ansi->stlen );
+	    dest += ansi->stlen;
+	}
+	p += 3;
+    }
+    return dest;
+}
+
+/*
+ * Flood control.  A link with more than OUT_HIGH_WATER queued is flooded
+ * until it drains to OUT_LOW_WATER.  While it is, channels and broadcasts
+ * to it are shed (output_shed), and if it stays that way for
+ * OUT_FLOOD_TIME the game loop hangs up on it.  Called whenever the
+ * amount queued changes.
+ */
+static void output_level( DESCRIPTOR_DATA *d )
+{
+    int pending = OUT_PENDING( d );
+
+    if ( pending > d->outpeak )
+	d->outpeak = pending;
+
+    if ( !IS_SET( d->flags, DESC_FLAG_OUTFLOODED ) )
+    {
+	if ( pending >= OUT_HIGH_WATER )
+	{
+	    SET_BIT( d->flags, DESC_FLAG_OUTFLOODED );
+	    d->outflood = current_time;
+	}
+	return;
+    }
+
+    if ( pending > OUT_LOW_WATER )
+	return;
+    REMOVE_BIT( d->flags, DESC_FLAG_OUTFLOODED );
+    if ( IS_SET( d->flags, DESC_FLAG_OUTSHED ) )
+    {
+	REMOVE_BIT( d->flags, DESC_FLAG_OUTSHED );
+	write_to_buffer( d,
+	  "[Some channel messages were dropped while your link was behind.]\n\r", 0 );
+    }
+    return;
+}
+
+/*
+ * Should low priority output (channels, broadcasts) to d be dropped?
+ * Counts it if so.
+ */
+bool output_shed( DESCRIPTOR_DATA *d )
+{
+    if ( !IS_SET( OUT_POLICY, OUT_SHED )
+    ||   !IS_SET( d->flags, DESC_FLAG_OUTFLOODED ) )
+	return FALSE;
+    d->outdropped++;
+    SET_BIT( d->flags, DESC_FLAG_OUTSHED );
+    return TRUE;
+}
 
+/*
+ * Append onto an output buffer.
+ * If the text might not fit even with every third byte a colour code,
+ * the expanded length is worked out first, so the buffer is grown at
+ * most once a call.
+ */
 void write_to_buffer( DESCRIPTOR_DATA *d, const char *txt, int length )
 {
+    struct colour_set cs;
+    char *dest;
+    int need;
+
     if ( d == NULL )
       return;
 
@@ -2179,134 +2487,448 @@ void write_to_buffer( DESCRIPTOR_DATA *d, const char *txt, int length )
     /*
      * Initial \n\r if needed.
      */
-    if ( d->outtop == 0 && !d->fcommand )
+    if ( !HAS_OUTPUT( d ) && !d->fcommand )
     {
 	d->outbuf[0]    = '\n';
 	d->outbuf[1]    = '\r';
 	d->outtop       = 2;
     }
 
+    colour_set_for( d, &cs );
+
     /*
-     * Expand the buffer as needed.
+     * Grow the buffer, once, if the worst case doesn't fit.
      */
-    while ( d->outtop + length + 1 + color_MARGIN >= d->outsize )
+    need = length + ( length / 3 ) * ansi_grow;
+    if ( d->outtop + need + 1 >= d->outsize )
+	need = colour_length( &cs, txt, length );
+
+    if ( d->outtop + need + 1 >= d->outsize )
     {
 	char *outbuf;
+	int size = d->outsize;
 
-	outbuf      = getmem( 2 * d->outsize );
-	strncpy( outbuf, d->outbuf, d->outtop );
+	while ( d->outtop + need + 1 >= size )
+	    size *= 2;
+	outbuf      = getmem( size );
+	memcpy( outbuf, d->outbuf, d->outtop );
 	dispose( d->outbuf, d->outsize );
 	d->outbuf   = outbuf;
-	d->outsize *= 2;
+	d->outsize  = size;
     }
 
-    /*
-     * Copy.
-     */
-     
-    /* ONLY COPY length number of Bytes, otherwise things can go WRONG */
-    /* MAG mod to strncpy */
-    /* Old was  strcpy( d->outbuf + d->outtop, txt ); */
+    dest = colour_copy( &cs, d->outbuf + d->outtop, txt, length );
 
+    /* Make sure we have a \0 at the end */
+    *dest = '\0';
 
-    /* Before Mod2: strncpy( d->outbuf + d->outtop, txt, length ); */
-    
-    /* MAG Mod2: Convert color strings, while copying. Also expand buffer as neede. */
-    {
-     char c;
-     char lookup;
-     char *dest;
-     int count=length;
-     CHAR_DATA * ch;
-     char * colstr;
-     int collen,cnt;
-     
-     dest=d->outbuf + d->outtop;
-     
-     for ( ; count > 0; )
-     {
-      c=*(txt++);
-      if (c != '@')
-      {
-       *(dest++)=c;
-       count--;
-       continue;
-      }
-      else
-      {
-       if (*txt != '@')
-       {
-        *(dest++)=c;
-        count--;
-        continue;
-       }
-       
-       txt++; /* txt now points at color code. */
-       c=*(txt++); /* c is color code. */
-       length=length-3;
-       count=count-3;
-       
-       if (c=='@')
-       {
-        length++;
-        *(dest++)=c;
-        continue;
-       }
-       
-       ch= d->original != NULL ? d->original : d->character;
-       if (ch != NULL && !IS_SET(ch->config, CONFIG_COLOR))
-        continue;
-/* set to default highlight or dim set by player */
-       lookup = c;
-       if ( ch != NULL && !IS_NPC( ch ) )  /* shouldn't happen, but...*/
-       {
-         if ( lookup == '!' )
-           lookup = ch->pcdata->hicol;
-         else
-         if ( lookup == '.' )
-         lookup = ch->pcdata->dimcol;
-       }
+    d->outtop = dest - d->outbuf;
+    output_level( d );
+    return;
+}
 
-       for ( cnt = 0; cnt < MAX_ANSI; cnt ++ )
-        if ( ansi_table[cnt].letter == lookup )
-         break;
-      
-       if (cnt == MAX_ANSI)
-       {
-        colstr=ansi_table[10].value;
-        collen=ansi_table[10].stlen;
-       }
-       else
-       {
-        colstr=ansi_table[cnt].value;
-        collen=ansi_table[cnt].stlen;
-       }
-       
-       
-       while ( d->outtop + length + collen + 1 >= d->outsize )
-       {
-	char *outbuf;
+/*
+ * write_to_buffer's copy loop as it was before the lookup tables, kept
+ * for 'colourbench' to race against: a byte at a time, with a walk
+ * along ansi_table for every code.
+ */
+static char *colour_copy_slow( DESCRIPTOR_DATA *d, char *dest,
+			      const char *txt, int length )
+{
+    CHAR_DATA *ch;
+    char c;
+    char lookup;
+    int cnt;
 
-	outbuf      = getmem( 2 * d->outsize );
-	strncpy( outbuf, d->outbuf, d->outtop+length-count );
-	dispose( d->outbuf, d->outsize );
-	d->outbuf   = outbuf;
-	d->outsize *= 2;
-       }
-       
-       dest=d->outbuf+d->outtop+length-count;
-       strncpy( dest, colstr, collen);
-       dest+=collen;
-       
-       length=length+collen;
-      }
-     }
-    }    
-    
-    /* Make sure we have a \0 at the end */
-    *(d->outbuf+d->outtop+length)='\0';
-    
-    d->outtop += length;
+    while ( length > 0 )
+    {
+	c = *(txt++);
+	length--;
+	if ( c != '@' || length < 2 || *txt != '@' )
+	{
+	    *(dest++) = c;
+	    continue;
+	}
+	txt++;
+	c = *(txt++);
+	length -= 2;
+	if ( c == '@' )
+	{
+	    *(dest++) = c;
+	    continue;
+	}
+
+	ch = d->original != NULL ? d->original : d->character;
+	if ( ch != NULL && !IS_SET(ch->config, CONFIG_COLOR) )
+	    continue;
+	lookup = c;
+	if ( ch != NULL && !IS_NPC( ch ) )
+	{
+	    if ( lookup == '!' )
+		lookup = ch->pcdata->hicol;
+	    else if ( lookup == '.' )
+		lookup = ch->pcdata->dimcol;
+	}
+	for ( cnt = 0; cnt < MAX_ANSI; cnt++ )
+	    if ( ansi_table[cnt].letter == lookup )
+		break;
+	if ( cnt == MAX_ANSI )
+	    cnt = 10;
+	strncpy( dest, ansi_table[cnt].value, ansi_table[cnt].stlen );
+	dest += ansi_table[cnt].stlen;
+    }
+    return dest;
+}
+
+/*
+ * colourbench [n]: expand a room description and a line of combat spam
+ * n times each, the old way and through the tables, with colour on and
+ * off, and check both ways give the same bytes.  It runs in the game
+ * loop, so n is kept small enough not to stall the mud: at the cap the
+ * eight runs take about a tenth of a second.
+ */
+void do_colourbench( CHAR_DATA *ch, char *argument )
+{
+    static char * const sample[2] =
+    {
+	"@@WThe Temple Of Mota@@N\n\r"
+	"  You are in the southern end of the temple hall in the Temple of "
+	"Mota.  The temple has been constructed from giant marble blocks, "
+	"eternal in appearance, and most of the walls are covered by ancient "
+	"wall paintings picturing gods, giants and peasants.\n\r"
+	"  Large steps lead down through the grand temple gate, descending "
+	"the huge mound upon which the temple is built and ends on the "
+	"temple square below.\n\r\n\r"
+	"@@e[Exits: @@Wnorth south@@e]@@N\n\r"
+	"@@d(@@!Glowing@@d) @@yA large sword lies here.@@N\n\r",
+	"@@eYour slash @@R***  DEVASTATES  ***@@e the @@yfido@@e! "
+	"@@.[@@!123@@.]@@N  @@@@ @@gYou parry.@@N\n\r"
+    };
+    static char * const sample_name[2] = { "room", "combat" };
+    char arg[MAX_INPUT_LENGTH];
+    char buf[MAX_STRING_LENGTH];
+    char out[2][MAX_STRING_LENGTH];
+    DESCRIPTOR_DATA *d = ch->desc;
+    CHAR_DATA *och;
+    struct colour_set cs;
+    long long took[2];
+    long long start;
+    char *end[2];
+    int wrong = 0;
+    int n, i, s, c, length;
+
+    if ( d == NULL )
+	return;
+    och = d->original != NULL ? d->original : d->character;
+    one_argument( argument, arg );
+    n = is_number( arg ) ? URANGE( 1, atoi( arg ), 20000 ) : 5000;
+
+    sprintf( buf, "%d runs of each, per call:\n\r%-17s %10s %10s\n\r",
+	n, "", "old", "new" );
+    send_to_char( buf, ch );
+    for ( c = 0; c < 2; c++ )
+    {
+	/* Colour on, then off; the caller's own setting is put back. */
+	bool was = IS_SET( och->config, CONFIG_COLOR ) ? TRUE : FALSE;
+
+	if ( c == 0 )
+	    SET_BIT( och->config, CONFIG_COLOR );
+	else
+	    REMOVE_BIT( och->config, CONFIG_COLOR );
+
+	for ( s = 0; s < 2; s++ )
+	{
+	    length = strlen( sample[s] );
+	    end[0] = out[0];
+	    end[1] = out[1];
+
+	    start = current_usec( );
+	    for ( i = 0; i < n; i++ )
+		end[0] = colour_copy_slow( d, out[0], sample[s], length );
+	    took[0] = current_usec( ) - start;
+
+	    start = current_usec( );
+	    for ( i = 0; i < n; i++ )
+	    {
+		colour_set_for( d, &cs );
+		end[1] = colour_copy( &cs, out[1], sample[s], length );
+	    }
+	    took[1] = current_usec( ) - start;
+
+	    if ( end[0] - out[0] != end[1] - out[1]
+	    ||   memcmp( out[0], out[1], end[0] - out[0] ) )
+		wrong++;
+
+	    sprintf( buf, "%-10s %-6s %8lldns %8lldns\n\r",
+		c == 0 ? "colour," : "no colour,", sample_name[s],
+		took[0] * 1000 / n, took[1] * 1000 / n );
+	    send_to_char( buf, ch );
+	}
+
+	if ( was )
+	    SET_BIT( och->config, CONFIG_COLOR );
+	else
+	    REMOVE_BIT( och->config, CONFIG_COLOR );
+    }
+
+    if ( wrong > 0 )
+    {
+	sprintf( buf, "%d of the expansions came out different!\n\r", wrong );
+	send_to_char( buf, ch );
+    }
+    return;
+}
+
+
+
+/*
+ * Shared output segments.
+ */
+static void output_unref( OUT_SEG *seg )
+{
+    if ( --seg->refs > 0 )
+	return;
+    dispose( seg, sizeof( *seg ) + seg->len + 1 );
+    return;
+}
+
+static void output_link( DESCRIPTOR_DATA *d, OUT_SEG *seg, int start, int end )
+{
+    OUT_QUEUE *q;
+
+    GET_FREE( q, outq_free );
+    q->seg   = seg;
+    q->start = start;
+    q->end   = end;
+    LINK( q, d->first_outq, d->last_outq, next, prev );
+    return;
+}
+
+/*
+ * Queue a shared segment on d, after anything already written to it.
+ */
+static void write_segment( DESCRIPTOR_DATA *d, OUT_SEG *seg )
+{
+    if ( !HAS_OUTPUT( d ) && !d->fcommand )
+    {
+	d->outbuf[0]    = '\n';
+	d->outbuf[1]    = '\r';
+	d->outtop       = 2;
+    }
+
+    if ( d->outtop > d->outmark )
+    {
+	output_link( d, NULL, d->outmark, d->outtop );
+	d->outmark = d->outtop;
+    }
+    seg->refs++;
+    output_link( d, seg, 0, seg->len );
+    d->outqueued += seg->len;
+    output_level( d );
+    return;
+}
+
+/*
+ * Throw away everything waiting to go to d.
+ */
+void discard_output( DESCRIPTOR_DATA *d )
+{
+    OUT_QUEUE *q;
+
+    while ( ( q = d->first_outq ) != NULL )
+    {
+	UNLINK( q, d->first_outq, d->last_outq, next, prev );
+	if ( q->seg != NULL )
+	    output_unref( q->seg );
+	PUT_FREE( q, outq_free );
+    }
+    d->outtop    = 0;
+    d->outmark   = 0;
+    d->outqueued = 0;
+    d->outflush  = 0;
+    REMOVE_BIT( d->flags, DESC_FLAG_OUTFLOODED | DESC_FLAG_OUTSHED | DESC_FLAG_PROMPTDUE );
+    return;
+}
+
+/*
+ * Drop the first n bytes of d's output, which the socket has taken.
+ */
+void output_consume( DESCRIPTOR_DATA *d, int n )
+{
+    OUT_QUEUE *q;
+    OUT_QUEUE *q_next;
+    int used = 0;		/* bytes of outbuf gone */
+    int k;
+
+    for ( q = d->first_outq; q != NULL; q = q_next )
+    {
+	q_next = q->next;
+	k = UMIN( n, q->end - q->start );
+	q->start += k;
+	n -= k;
+	if ( q->seg != NULL )
+	    d->outqueued -= k;
+	else
+	    used += k;
+	if ( q->start < q->end )
+	    break;
+
+	UNLINK( q, d->first_outq, d->last_outq, next, prev );
+	if ( q->seg != NULL )
+	    output_unref( q->seg );
+	PUT_FREE( q, outq_free );
+    }
+    if ( d->first_outq == NULL )
+	used += n;
+
+    if ( used == 0 )
+    {
+	output_level( d );
+	return;
+    }
+    memmove( d->outbuf, d->outbuf + used, d->outtop - used );
+    d->outtop -= used;
+    d->outmark = d->first_outq == NULL ? 0 : d->outmark - used;
+    for ( q = d->first_outq; q != NULL; q = q->next )
+	if ( q->seg == NULL )
+	{
+	    q->start -= used;
+	    q->end   -= used;
+	}
+    output_level( d );
+    return;
+}
+
+/*
+ * Point iov at the start of d's output.  Returns how many are used.
+ */
+int output_iov( DESCRIPTOR_DATA *d, struct iovec *iov, int *total )
+{
+    OUT_QUEUE *q;
+    int n = 0;
+
+    *total = 0;
+    for ( q = d->first_outq; q != NULL && n < OUT_IOV; q = q->next, n++ )
+    {
+	iov[n].iov_base = ( q->seg != NULL ? q->seg->text : d->outbuf ) + q->start;
+	iov[n].iov_len  = q->end - q->start;
+	*total += iov[n].iov_len;
+    }
+    if ( q == NULL && n < OUT_IOV && d->outtop > d->outmark )
+    {
+	iov[n].iov_base = d->outbuf + d->outmark;
+	iov[n].iov_len  = d->outtop - d->outmark;
+	*total += iov[n].iov_len;
+	n++;
+    }
+    return n;
+}
+
+/*
+ * Give d's snooper everything after the first skip bytes of its output.
+ */
+void output_snoop( DESCRIPTOR_DATA *d, int skip )
+{
+    OUT_QUEUE *q;
+    const char *text;
+    int len;
+
+    for ( q = d->first_outq; ; q = q->next )
+    {
+	if ( q != NULL )
+	{
+	    text = ( q->seg != NULL ? q->seg->text : d->outbuf ) + q->start;
+	    len  = q->end - q->start;
+	}
+	else
+	{
+	    text = d->outbuf + d->outmark;
+	    len  = d->outtop - d->outmark;
+	}
+	if ( len > skip )
+	    write_to_buffer( d->snoop_by, text + skip, len - skip );
+	skip = UMAX( 0, skip - len );
+	if ( q == NULL )
+	    break;
+    }
+    return;
+}
+
+/*
+ * Broadcasts.  cast_init takes the text, cast_to queues it on each
+ * reader, expanding it once for each colour setting seen (up to
+ * OUT_CAST_MODES, copying after that), and cast_done lets go.  Text
+ * that would make a reader's pager stop goes through send_to_char.
+ */
+void cast_init( OUT_CAST *cast, const char *txt )
+{
+    const char *p;
+
+    cast->txt   = txt;
+    cast->len   = strlen( txt );
+    cast->lines = 0;
+    cast->top   = 0;
+    for ( p = txt; ( p = strchr( p, '\n' ) ) != NULL; p++ )
+	cast->lines++;
+    return;
+}
+
+void cast_to( OUT_CAST *cast, DESCRIPTOR_DATA *d )
+{
+    struct colour_set cs;
+    CHAR_DATA *ch = d->character;
+    OUT_SEG *seg;
+    int mode;
+    int i;
+
+    if ( ch == NULL || cast->len == 0 || output_shed( d ) )
+	return;
+    if ( d->showstr_head != NULL
+    ||   cast->len >= MAX_STRING_LENGTH
+    ||   ( !IS_NPC( ch ) && cast->lines >= ch->pcdata->pagelen ) )
+    {
+	send_to_char( cast->txt, ch );
+	return;
+    }
+
+    colour_set_for( d, &cs );
+    mode = cs.lookup == ansi_plain ? 0
+	 : 1 << 16
+	 | ( cs.hi  != NULL ? (unsigned char) cs.hi->letter  : 0 ) << 8
+	 | ( cs.dim != NULL ? (unsigned char) cs.dim->letter : 0 );
+
+    for ( i = 0; i < cast->top; i++ )
+	if ( cast->mode[i] == mode )
+	    break;
+    if ( i == cast->top )
+    {
+	int len;
+
+	if ( cast->top >= OUT_CAST_MODES )
+	{
+	    write_to_buffer( d, cast->txt, cast->len );
+	    return;
+	}
+	len		= colour_length( &cs, cast->txt, cast->len );
+	seg		= getmem( sizeof( *seg ) + len + 1 );
+	seg->text	= (char *) ( seg + 1 );
+	seg->len	= colour_copy( &cs, seg->text, cast->txt, cast->len ) - seg->text;
+	seg->refs	= 1;			/* the cast's */
+	cast->mode[i]	= mode;
+	cast->seg[i]	= seg;
+	cast->top++;
+    }
+    write_segment( d, cast->seg[i] );
+    return;
+}
+
+void cast_done( OUT_CAST *cast )
+{
+    int i;
+
+    for ( i = 0; i < cast->top; i++ )
+	output_unref( cast->seg[i] );
+    cast->top = 0;
     return;
 }
 
@@ -2344,6 +2966,31 @@ bool write_to_descriptor( int desc, char *txt, int length )
 
 
 
+/*
+ * As write_to_descriptor, but gathers from an iovec and stops when the
+ * socket would block instead of treating it as an error.  Returns how
+ * much was written, or -1 if the connection is gone.
+ */
+int writev_nonblocking( int desc, struct iovec *iov, int niov )
+{
+    int nWrite;
+
+    for ( ; ; )
+    {
+	if ( ( nWrite = writev( desc, iov, niov ) ) >= 0 )
+	    return nWrite;
+	if ( errno == EWOULDBLOCK || errno == EAGAIN )
+	    return 0;
+	if ( errno != EINTR )
+	{
+	    perror( "Writev_nonblocking" );
+	    return -1;
+	}
+    }
+}
+
+
+
 void show_menu_to( DESCRIPTOR_DATA *d )
 {
    CHAR_DATA *ch = d->character;
@@ -2649,11 +3296,7 @@ void nanny( DESCRIPTOR_DATA *d, char *argument )
 
 	if ( fOld )
 	{
-          BAN_DATA *pban;
-
-          for ( pban = first_ban; pban != NULL; pban = pban->next )
-          {
-	    if ( !str_prefix( pban->name, d->host ) && ( pban->newbie == FALSE ) )
+	    if ( check_ban( d, FALSE ) != NULL )
 	    {
 	      char buf[MAX_STRING_LENGTH];
               sprintf( buf, "Denying access to banned site %s", d->host );
@@ -2664,7 +3307,6 @@ void nanny( DESCRIPTOR_DATA *d, char *argument )
 	      close_socket( d );
 	      return;
 	    }
-          }
 
 	    /* Old player */
 	  write_to_buffer( d, "Password: ", 0 );
@@ -2674,16 +3316,12 @@ void nanny( DESCRIPTOR_DATA *d, char *argument )
 	}
 	else
 	{
-          BAN_DATA *pban;
 	    /* New player */
 	    /* New characters with same name fix by Salem's Lot */
 	    if ( check_playing( d, ch->name ) )
 		return;
 
-          for ( pban = first_ban; pban != NULL; pban = pban->next )
-          {
-	    if (  !str_prefix( pban->name, d->host ) )
-                 
+	    if ( check_ban( d, TRUE ) != NULL )
 	    {
 	      char buf[MAX_STRING_LENGTH];
               sprintf( buf, "Denying access to banned site %s", d->host );
@@ -2694,7 +3332,6 @@ void nanny( DESCRIPTOR_DATA *d, char *argument )
 	      close_socket( d );
 	      return;
 	    }
-          }
  
 
 	    sprintf( buf, "Did I get that right, %s (Y/N)? ", argument );
@@ -3056,7 +3693,7 @@ void nanny( DESCRIPTOR_DATA *d, char *argument )
 	   ch->lvl[ch->class] = 1;
 	}
 	
-	LINK(ch, first_char, last_char, next, prev);
+	char_to_list( ch );
 	d->connected    = CON_PLAYING;
 
 	
@@ -3333,15 +3970,15 @@ void nanny( DESCRIPTOR_DATA *d, char *argument )
           UNLINK( this_aff, ch->first_saved_aff, ch->last_saved_aff, next, prev );
           
              
-          if ( this_aff->type == skill_lookup( "fireshield" ) )
+          if ( this_aff->type == gsn_fireshield )
             do_cast( ch, "fireshield");
-          else if ( this_aff->type == skill_lookup( "iceshield"  ) )
+          else if ( this_aff->type == gsn_iceshield )
             do_cast( ch, "iceshield" );
-          else if ( this_aff->type == skill_lookup( "shockshield" ) )
+          else if ( this_aff->type == gsn_shockshield )
             do_cast( ch, "shockshield");
-          else if ( this_aff->type == skill_lookup( "shadowshield" ) )
+          else if ( this_aff->type == gsn_shadowshield )
             do_cast( ch, "shadowshield" );
-          else if ( this_aff->type == skill_lookup( "thoughtshield" ) )   
+          else if ( this_aff->type == gsn_thoughtshield )   
             do_cast( ch, "thoughtshield" );
           else
             affect_to_char( ch, this_aff );
@@ -3685,19 +4322,33 @@ void show_string(struct descriptor_data *d, char *input)
 }
 
 /*
- * The primary output interface for formatted output.
+ * act() renders its format once for each visibility class in the room
+ * instead of once for each person.  The only parts of a rendering that
+ * depend on who reads it are whether they can see $n, $N, $p and $P,
+ * so those four answers make the class, and everyone in a class is
+ * sent the same buffer.  $L (sneak and wizinvis) decides whether a
+ * reader gets the message at all, so it is still rolled per person.
  */
-void act( const char *format, CHAR_DATA *ch, const void *arg1,
-	 const void *arg2, int type )
+#define ACT_SEE_CH	1
+#define ACT_SEE_VCH	2
+#define ACT_SEE_OBJ1	4
+#define ACT_SEE_OBJ2	8
+#define ACT_CLASSES	16
+#define ACT_CACHE	4	/* renderings kept per call */
+
+/*
+ * Format one rendering of an act() message as seen by to.  Channels
+ * use it to render once and cast_to the result.
+ */
+int act_format( char *buf, const char *format, CHAR_DATA *ch,
+	       const void *arg1, const void *arg2, CHAR_DATA *to )
 {
     static char * const he_she  [] = { "it",  "he",  "she" };
     static char * const him_her [] = { "it",  "him", "her" };
     static char * const his_her [] = { "its", "his", "her" };
 
-    char buf[MAX_STRING_LENGTH];
     char fname[MAX_INPUT_LENGTH];
     char tmp_str[MSL];
-    CHAR_DATA *to;
     CHAR_DATA *vch = (CHAR_DATA *) arg2;
     OBJ_DATA *obj1 = (OBJ_DATA  *) arg1;
     OBJ_DATA *obj2 = (OBJ_DATA  *) arg2;
@@ -3705,60 +4356,6 @@ void act( const char *format, CHAR_DATA *ch, const void *arg1,
     const char *i = "";
     char *point;
     bool do_crlf = TRUE;
-    bool can_see_message = TRUE;
-
-    /*
-     * Discard null and zero-length messages.
-     */
-    if ( format == NULL || format[0] == '\0' )
-	return;
-
-    if  ( ch == NULL )
-   
-      return;
-
-    if (  ( ch->is_free != FALSE )  
-       || ( ch->in_room == NULL ) )
-    {
-      bugf("bad ch, string=%s", format);
-      return;
-    }
-
-    to = ch->in_room->first_person;
-    if ( type == TO_VICT )
-    {
-	if ( vch == NULL )
-	{
-	    bugf( "Act: null vch with TO_VICT, string=%s", format );
-	    return;
-	}
-	to = vch->in_room->first_person;
-    }
-    
-    for ( ; to != NULL; to = to->next_in_room )
-    {
-	if ( ( to->desc == NULL 
-	    && ( IS_NPC( to ) && !(to->pIndexData->progtypes & ACT_PROG ) ) )
-	    || !IS_AWAKE(to) )
-	    continue;
-
-	if ( type == TO_CHAR && to != ch )
-	    continue;
-	if ( type == TO_VICT && ( to != vch || to == ch ) )
-	    continue;
-	if ( type == TO_ROOM && to == ch )
-	    continue;
-	if ( type == TO_NOTVICT && (to == ch || to == vch) )
-	    continue;
-
-        /* Check for Bash and vannevar *sigh* */
-        if ( !IS_NPC(ch) && !IS_NPC(ch) && !str_cmp(ch->name,"bash")
-	     && !str_cmp(to->name,"vannevar") )
-	    continue;
-	if ( !IS_NPC(ch) && !IS_NPC(ch) && !str_cmp(ch->name,"vannevar")
-	     && !str_cmp(to->name,"bash") )
-	    continue;
-
 
 	point   = buf;
 	str     = format;
@@ -3795,25 +4392,7 @@ void act( const char *format, CHAR_DATA *ch, const void *arg1,
 	 	  default:  bugf( "Act: bad code $%c, string=%s", *str, format );
 			  i = " !!!!! ";                                break;
 		/* Thx alex for 't' idea */
-                  case 'L': can_see_message = TRUE;
-                      if ( IS_IMMORTAL( to ) )
-                      {
-                        if ( IS_SET( ch->act, PLR_WIZINVIS ) 
-					&& ch->invis > get_trust( to ) 
-		/*	|| ( IS_SET( ch->act, PLR_INCOG )
-					&& ch->incog > get_trust( to )*/ )
-                          can_see_message = FALSE;
-                      }
-                      else
-                      {
-                        if ( IS_SET( ch->act, PLR_WIZINVIS ) && get_trust( to ) < ch->invis )
-                            can_see_message = FALSE;
-                        if (  ( IS_AFFECTED(ch, AFF_SNEAK) || item_has_apply( ch, ITEM_APPLY_SNEAK ) )
-                           && (  ( get_psuedo_level( ch ) - 20 + number_range( 1, 30 ) ) > get_psuedo_level( to )  )  )
-                          can_see_message = FALSE;
-                      }
-                      break;
-
+		  case 'L': /* see act_see_message */                   break;
 		  case 't': i = (char *) arg1;                            break;
 		  case 'T': i = (char *) arg2;                            break;
 		  case 'n': i = PERS( ch,  to  );                         break;
@@ -3877,10 +4456,162 @@ if ( do_crlf )
 	 }
 	buf[0]   = UPPER(buf[0]);
         *point = '\0';
+    return point - buf;
+}
+
+/*
+ * $L: does to get the message at all?  Sneakers roll against each reader.
+ */
+static bool act_see_message( CHAR_DATA *ch, CHAR_DATA *to )
+{
+    if ( IS_IMMORTAL( to ) )
+    {
+	if ( IS_SET( ch->act, PLR_WIZINVIS ) 
+			&& ch->invis > get_trust( to ) 
+	/*	|| ( IS_SET( ch->act, PLR_INCOG )
+			&& ch->incog > get_trust( to )*/ )
+	  return FALSE;
+    }
+    else
+    {
+	if ( IS_SET( ch->act, PLR_WIZINVIS ) && get_trust( to ) < ch->invis )
+	    return FALSE;
+	if (  ( IS_AFFECTED(ch, AFF_SNEAK) || item_has_apply( ch, ITEM_APPLY_SNEAK ) )
+	   && (  ( get_psuedo_level( ch ) - 20 + number_range( 1, 30 ) ) > get_psuedo_level( to )  )  )
+	  return FALSE;
+    }
+    return TRUE;
+}
+
+/*
+ * The primary output interface for formatted output.
+ */
+void act( const char *format, CHAR_DATA *ch, const void *arg1,
+	 const void *arg2, int type )
+{
+    char buf[MAX_STRING_LENGTH];
+    char cache[ACT_CACHE][MAX_STRING_LENGTH];
+    int cache_len[ACT_CACHE];
+    int slot[ACT_CLASSES];
+    CHAR_DATA *to;
+    CHAR_DATA *vch = (CHAR_DATA *) arg2;
+    OBJ_DATA *obj1 = (OBJ_DATA  *) arg1;
+    OBJ_DATA *obj2 = (OBJ_DATA  *) arg2;
+    const char *str;
+    char *out;
+    int len;
+    int need;
+    int class;
+    int used;
+    bool fSeeMessage;
+    bool can_see_message = TRUE;
+
+    /*
+     * Discard null and zero-length messages.
+     */
+    if ( format == NULL || format[0] == '\0' )
+	return;
+
+    if  ( ch == NULL )
+   
+      return;
+
+    if (  ( ch->is_free != FALSE )  
+       || ( ch->in_room == NULL ) )
+    {
+      bugf("bad ch, string=%s", format);
+      return;
+    }
+
+    to = ch->in_room->first_person;
+    if ( type == TO_VICT )
+    {
+	if ( vch == NULL )
+	{
+	    bugf( "Act: null vch with TO_VICT, string=%s", format );
+	    return;
+	}
+	to = vch->in_room->first_person;
+    }
+
+    /*
+     * Which codes in the format depend on the reader?
+     */
+    need = 0;
+    fSeeMessage = FALSE;
+    for ( str = format; ( str = strchr( str, '$' ) ) != NULL && str[1] != '\0'; str += 2 )
+    {
+	switch ( str[1] )
+	{
+	  case 'n': need |= ACT_SEE_CH;				break;
+	  case 'N': if ( vch  ) need |= ACT_SEE_VCH;		break;
+	  case 'p': if ( obj1 ) need |= ACT_SEE_OBJ1;		break;
+	  case 'P': if ( obj2 ) need |= ACT_SEE_OBJ2;		break;
+	  case 'L': fSeeMessage = TRUE;				break;
+	}
+    }
+    for ( class = 0; class < ACT_CLASSES; class++ )
+	slot[class] = -1;
+    used = 0;
+    
+    for ( ; to != NULL; to = to->next_in_room )
+    {
+	if ( ( to->desc == NULL 
+	    && !( IS_NPC( to ) && ( to->pIndexData->progtypes & ACT_PROG ) ) )
+	    || !IS_AWAKE(to) )
+	    continue;
+
+	if ( type == TO_CHAR && to != ch )
+	    continue;
+	if ( type == TO_VICT && ( to != vch || to == ch ) )
+	    continue;
+	if ( type == TO_ROOM && to == ch )
+	    continue;
+	if ( type == TO_NOTVICT && (to == ch || to == vch) )
+	    continue;
+
+        /* Check for Bash and vannevar *sigh* */
+        if ( !IS_NPC(ch) && !IS_NPC(ch) && !str_cmp(ch->name,"bash")
+	     && !str_cmp(to->name,"vannevar") )
+	    continue;
+	if ( !IS_NPC(ch) && !IS_NPC(ch) && !str_cmp(ch->name,"vannevar")
+	     && !str_cmp(to->name,"bash") )
+	    continue;
+
+	if ( fSeeMessage )
+	    can_see_message = act_see_message( ch, to );
+
+	class = 0;
+	if ( ( need & ACT_SEE_CH ) && can_see( to, ch ) )
+	    class |= ACT_SEE_CH;
+	if ( ( need & ACT_SEE_VCH ) && can_see( to, vch ) )
+	    class |= ACT_SEE_VCH;
+	if ( ( need & ACT_SEE_OBJ1 ) && can_see_obj( to, obj1 ) )
+	    class |= ACT_SEE_OBJ1;
+	if ( ( need & ACT_SEE_OBJ2 ) && can_see_obj( to, obj2 ) )
+	    class |= ACT_SEE_OBJ2;
+
+	if ( slot[class] >= 0 )
+	{
+	    out = cache[slot[class]];
+	    len = cache_len[slot[class]];
+	}
+	else if ( used < ACT_CACHE )
+	{
+	    slot[class] = used++;
+	    out = cache[slot[class]];
+	    len = cache_len[slot[class]] = act_format( out, format, ch, arg1, arg2, to );
+	}
+	else
+	{
+	    out = buf;
+	    len = act_format( out, format, ch, arg1, arg2, to );
+	}
+
 	if (to->desc && can_see_message )
-	  write_to_buffer( to->desc, buf, point - buf );
-	if (MOBtrigger)
-	  mprog_act_trigger( buf, to, ch, obj1, vch );
+	  write_to_buffer( to->desc, out, len );
+	if ( MOBtrigger && IS_NPC( to ) && ( to->pIndexData->progtypes & ACT_PROG ) )
+	  mprog_act_trigger( out, to, ch, obj1, vch );
 						    /* Added by Kahn */
     }
 
@@ -4090,8 +4821,22 @@ void copyover_recover ()
 		
 		GET_FREE (d, desc_free);
 		init_descriptor (d,desc); /* set up various stuff */
+		netpoll_add (desc, d);
 		
 		d->host = str_dup (host);
+		{
+		    struct sockaddr_in sock;
+		    socklen_t size = sizeof(sock);
+
+		    if ( getpeername( desc, (struct sockaddr *) &sock, &size ) == 0 )
+		    {
+			int addr = ntohl( sock.sin_addr.s_addr );
+
+			sprintf( d->ip, "%d.%d.%d.%d",
+			    ( addr >> 24 ) & 0xFF, ( addr >> 16 ) & 0xFF,
+			    ( addr >>  8 ) & 0xFF, ( addr       ) & 0xFF );
+		    }
+		}
 		d->next = NULL;
           d->prev = NULL;
 		   
@@ -4123,7 +4868,7 @@ void copyover_recover ()
                d->character->prev = NULL;
                this_char = d->character;
 
-			LINK( this_char, first_char, last_char, next, prev );
+			char_to_list( this_char );
 
 			char_to_room (d->character, d->character->in_room);
                         if ( d->character->position == POS_RIDING )
@@ -4170,15 +4915,15 @@ void copyover_recover ()
           UNLINK( this_aff, this_char->first_saved_aff, this_char->last_saved_aff, next, prev );
          
              
-          if ( this_aff->type == skill_lookup( "fireshield" ) )
+          if ( this_aff->type == gsn_fireshield )
             do_cast( this_char, "fireshield");
-          else if ( this_aff->type == skill_lookup( "iceshield"  ) )
+          else if ( this_aff->type == gsn_iceshield )
             do_cast( this_char, "iceshield" );
-          else if ( this_aff->type == skill_lookup( "shockshield" ) )
+          else if ( this_aff->type == gsn_shockshield )
             do_cast( this_char, "shockshield");
-          else if ( this_aff->type == skill_lookup( "shadowshield" ) )
+          else if ( this_aff->type == gsn_shadowshield )
             do_cast( this_char, "shadowshield" );
-          else if ( this_aff->type == skill_lookup( "thoughtshield" ) )   
+          else if ( this_aff->type == gsn_thoughtshield )   
             do_cast( this_char, "thoughtshield" );
           else
              affect_to_char( this_char, this_aff );
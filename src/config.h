@@ -46,6 +46,9 @@
 #define MAX_INPUT_LENGTH          640
 #define MAX_AREAS                 200
 #define MAX_VNUM 32767
+#define SLAB_SIZE		  8192	/* bytes per slab of freelist objects */
+#define SLAB_MIN_OBJS		     4	/* ...but at least this many a slab */
+#define SLAB_HOLD		    60	/* seconds an empty slab is kept */
 
 #define BOOT_DB_ABORT_THRESHOLD			  25
 #define RUNNING_ABORT_THRESHOLD			  10
@@ -60,12 +63,20 @@
 #define MAX_CLAN_EQ		     6  /* Number of clan eq items */
 #define MAX_color		    15  /* eg look, prompt, shout */
 #define MAX_ANSI		    28  /* eg red, black, etc (was 11) */
+#define OUT_CAST_MODES		     4  /* colour settings per broadcast */
+#define OUT_IOV			    32  /* iovecs per writev */
+#define OUT_HIGH_WATER		 65536  /* queued output that floods a link */
+#define OUT_LOW_WATER		 16384  /* ...and that it has to drain to */
+#define OUT_MAX_QUEUED	       1048576  /* queued output we'll ever hold */
+#define OUT_FLOOD_TIME		   120  /* seconds flooded before hanging up */
 #define MAX_ALIASES		     6
 #define MAX_IGNORES		     3
 #define MAX_RACE                     16
 #define MAX_CLAN                     9  /* number of clans */
 #define EXP_LEVEL                 1000  /* exp per level */
 #define MAX_SKILL                  300
+#define SKILL_HASH                 256  /* skill_lookup answers kept   */
+#define NAME_HASH                 1024  /* buckets for character names */
 #define MAX_CLASS                    5
 #define MAX_LEVEL                   85
 #define MOUNT_COST                  10
@@ -89,6 +100,14 @@
 
 #define MAX_TRADE        5
 
+/*
+ * What to do about a flooded link (see output_level in comm.c).
+ */
+#define OUT_SHED		     1  /* drop channels and broadcasts */
+#define OUT_COALESCE		     2  /* one prompt when it drains */
+#define OUT_HANGUP		     4  /* disconnect after OUT_FLOOD_TIME */
+#define OUT_POLICY		( OUT_SHED | OUT_COALESCE | OUT_HANGUP )
+
 /*
  * Liquids.
  */
@@ -198,7 +217,9 @@
 #define OBJ_VNUM_QUEST_MAX		18192   /* more to follow, up to 18199  */
 
 
+#define MAX_LISTEN		     4	/* listening sockets polled per pulse */
 #define PULSE_PER_SECOND             8
+#define PULSE_USEC                ( 1000000 / PULSE_PER_SECOND )
 #define PULSE_VIOLENCE            (  2 * PULSE_PER_SECOND )
 #define PULSE_MOBILE              (  4 * PULSE_PER_SECOND )
 #define PULSE_OBJFUN		  (  4 * PULSE_PER_SECOND )
@@ -210,6 +231,60 @@
 #define PULSE_RAUCTION            ( 30 * PULSE_PER_SECOND )
 #define PULSE_MAUCTION            ( 30 * PULSE_PER_SECOND )
 
+/*
+ * Parts of the pulse timed by the pulse profiler, see pulsestat.c.
+ */
+#define PSTAT_PULSE		0	/* everything but the sleep  */
+#define PSTAT_INPUT		1
+#define PSTAT_IMC		2
+#define PSTAT_UPDATE		3	/* all of update_handler     */
+#define PSTAT_OUTPUT		4
+#define PSTAT_VIOLENCE		5
+#define PSTAT_MOBILE		6
+#define PSTAT_AGGR		7
+#define PSTAT_CHAR		8
+#define PSTAT_OBJ		9
+#define PSTAT_ROOMS		10
+#define PSTAT_AREA		11
+#define PSTAT_MESSAGE		12
+#define PSTAT_AUCTION		13
+#define PSTAT_OBJFUN		14
+#define PSTAT_GAIN		15
+#define PSTAT_WEATHER		16
+#define PSTAT_QUEST		17
+#define MAX_PSTAT		18
+#define PSTAT_RING		512	/* samples kept per part     */
+
+/*
+ * Per-command statistics, see interp.c.
+ */
+#define CMDSTAT_ARG_SLOTS	16	/* arguments tracked per cmd */
+#define CMDSTAT_ARGS		3	/* ... and how many shown    */
+#define CMDSTAT_ARG_LEN		40	/* how much of each is kept  */
+#define CMDSTAT_SHOW		25	/* lines shown by 'cmdstat'  */
+
+/*
+ * Kinds of memory counted by allocation site, see memstat.c.
+ */
+#define MEM_GETMEM		0
+#define MEM_SHARED		1	/* str_dup into the SSM heap */
+#define MEM_OVERFLOW		2	/* ...and out of it          */
+#define MEM_FREELIST		3	/* GET_FREE                  */
+#define MAX_MEM_KIND		4
+#define MEM_SITES		2048	/* a power of two            */
+#define MEMSTAT_SHOW		25	/* lines shown by 'memstat'  */
+
+/*
+ * Help searches, see helpidx.c.
+ */
+#define HELP_SHOW		20	/* helps listed for a search  */
+#define HELP_WORDS		8	/* words looked for in text   */
+
+/*
+ * Pathfinding, see hunt.c.
+ */
+#define HUNT_TREE_CACHE		16	/* next-hop trees kept        */
+
 
 #define VAMPIRE_RECALL		 9001
 #define LIQUID_BLOOD		 13
@@ -421,6 +496,8 @@
 						/* For Hotreboot */
 #define CON_QUITTING			-15
 #define CON_RECONNECTING                -16
+#define CON_RESOLVING                   -17
+						/* Waiting on reverse DNS */
 #define CON_SETTING_STATS		1
 
 /* values used to check a new player has selected all options.... */
@@ -1251,6 +1328,8 @@
 #define BRANDS_FILE	DATA_DIR "brands.lst"
 
 #define SYSDAT_FILE	DATA_DIR "system.dat"
+#define PULSESTAT_FILE	"../log/pulsestat.txt"	/* 'pulsestat log' */
+#define CMDSTAT_FILE	"../log/cmdstat.txt"	/* daily command statistics */
 
 #if defined(SOE) && !defined(SOETEST) && !defined(SOEBLD)
 #define WHO_HTML_FILE   "/home/ftp/pub/webpage/soewholist.html"  /* for ftping who list to html web page :) */
@@ -1047,7 +1047,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"armor",                {  3,  82, 82, 82, 82 },
 	spell_armor,            TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT( 1),        5,     12,
+	&gsn_armor,             SLOT( 1),        5,     12,
 	"",                     "You feel less protected.",
 	""
     },
@@ -1084,7 +1084,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"bless",                { 82, 8, 82, 82, 82 },
 	spell_bless,            TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT( 3),        5,     12,
+	&gsn_bless,             SLOT( 3),        5,     12,
 	"",                     "You feel less righteous.",
 	"$n looks less Holy."
     },
@@ -1203,7 +1203,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"continual light",      {  11, 27, 82, 82, 82 },
 	spell_continual_light,  TAR_IGNORE,             POS_STANDING,
-	NULL,                   SLOT(57),        7,     12,
+	&gsn_continual_light,   SLOT(57),        7,     12,
 	"",                     "!Continual Light!",
 	""
     },
@@ -1248,7 +1248,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"cure blindness",       { 82,  28, 82, 82, 82 },
 	spell_cure_blindness,   TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(14),        5,     12,
+	&gsn_cure_blindness,    SLOT(14),        5,     12,
 	"",                     "!Cure Blindness!",
 	""
     },
@@ -1257,7 +1257,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"cure critical",        { 82, 59, 82, 82, 82 },
 	spell_cure_critical,    TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(15),       20,     12,
+	&gsn_cure_critical,     SLOT(15),       20,     12,
 	"",                     "!Cure Critical!",
 	""
     },
@@ -1266,7 +1266,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"cure light",           { 82,  5, 82, 82 ,82 },
 	spell_cure_light,       TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(16),       10,     12,
+	&gsn_cure_light,        SLOT(16),       10,     12,
 	"",                     "!Cure Light!",
 	""
     },
@@ -1275,7 +1275,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"cure poison",          { 82, 32, 82, 82, 82 },
 	spell_cure_poison,      TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT(43),        5,     12,
+	&gsn_cure_poison,       SLOT(43),        5,     12,
 	"",                     "!Cure Poison!",
 	""
     },
@@ -1284,7 +1284,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"cure serious",         { 82, 41, 82, 82 , 82 },
 	spell_cure_serious,     TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(61),       15,     12,
+	&gsn_cure_serious,      SLOT(61),       15,     12,
 	"",                     "!Cure Serious!",
 	""
     },
@@ -1320,7 +1320,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"detect invis",         {  19, 82, 82, 82, 82 },
 	spell_detect_invis,     TAR_CHAR_SELF,          POS_STANDING,
-	NULL,                   SLOT(19),        5,     12,
+	&gsn_detect_invis,      SLOT(19),        5,     12,
 	"",                     "You no longer see invisible objects.",
 	""
     },
@@ -1329,7 +1329,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"detect magic",         {  7, 7, 82, 82, 82 },
 	spell_detect_magic,     TAR_CHAR_SELF,          POS_STANDING,
-	NULL,                   SLOT(20),        5,     12,
+	&gsn_detect_magic,      SLOT(20),        5,     12,
 	"",                     "The detect magic wears off.",
 	""
     },
@@ -1347,7 +1347,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
        MORTAL, NORM,
        "detect undead",         { 8, 82, 82, 82, 82 },
        spell_detect_undead,     TAR_CHAR_SELF,          POS_STANDING,
-       NULL,                    SLOT(513),      8,      12,
+       &gsn_detect_undead,      SLOT(513),      8,      12,
        "",                      "You no longer sense undead beings.",
        ""
     },
@@ -1387,7 +1387,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"dispel magic",         { 68, 85, 85, 85, 85 },
 	spell_dispel_magic,     TAR_IGNORE,     POS_FIGHTING,
-	NULL,                   SLOT(59),       15,     12,
+	&gsn_dispel_magic,      SLOT(59),       15,     12,
 	"",                     "!Dispel Magic!",
 	""
     },
@@ -1508,7 +1508,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"fly",                  {  24, 82, 82, 82, 82 },
 	spell_fly,              TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT(56),       10,     18,
+	&gsn_fly,               SLOT(56),       10,     18,
 	"",                     "You slowly float to the ground.",
 	"$n slowly floats to the ground."
     },
@@ -1544,7 +1544,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"heal",                 { 82, 75, 82, 82, 82 },
 	spell_heal,             TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(28),       50,     12,
+	&gsn_heal,              SLOT(28),       50,     12,
 	"",                     "!Heal!",
 	""
     },
@@ -1572,7 +1572,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"infravision",          {  20,  82, 82, 82, 82 },
 	spell_infravision,      TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT(77),        5,     18,
+	&gsn_infravision,       SLOT(77),        5,     18,
 	"",                     "You no longer see in the dark.",
 	""
     },
@@ -1773,7 +1773,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"produce food",         { 82, 82, 82, 82, 24 },
 	spell_produce_food,     TAR_IGNORE,             POS_STANDING,
-	NULL,                   SLOT(524),      16,     24,
+	&gsn_produce_food,      SLOT(524),      16,     24,
 	"",                     "!Produce Food!",
 	""
     },
@@ -1782,7 +1782,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"protection",           { 9,  12, 82, 82, 82 },
 	spell_protection,       TAR_CHAR_SELF,          POS_STANDING,
-	NULL,                   SLOT(34),        5,     12,
+	&gsn_protection,        SLOT(34),        5,     12,
 	"",                     "You feel less protected.",
 	""
     },
@@ -1791,7 +1791,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"refresh",              {  82, 11, 82, 82, 82 },
 	spell_refresh,          TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT(81),       12,     18,
+	&gsn_refresh,           SLOT(81),       12,     18,
 	"refresh",              "!Refresh!",
 	""
     },
@@ -1809,7 +1809,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"sanctuary",            { 82, 70, 82, 82, 82},
 	spell_sanctuary,        TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT(36),       75,     12,
+	&gsn_sanctuary,         SLOT(36),       75,     12,
 	"",                     "The white aura around your body fades.",
 	"The white aura around $n's body fades."
     },
@@ -1903,7 +1903,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
         MORTAL, NORM,
 	"stone skin",           { 36, 82, 82, 82, 82},
 	spell_stone_skin,       TAR_CHAR_SELF,          POS_STANDING,
-	NULL,                   SLOT(66),       12,     18,
+	&gsn_stone_skin,        SLOT(66),       12,     18,
 	"",                     "Your skin feels soft again.",
 	"$n's skin loses it's stone-like look."
     },
@@ -2024,7 +2024,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"hellspawn",            { 43, 82, 82, 82, 82 },
 	spell_hellspawn,        TAR_CHAR_OFFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(512),      50,     12,
+	&gsn_hellspawn,         SLOT(512),      50,     12,
 	"HellSpawn",            "!Hellspawn!",
 	""
     },
@@ -2110,7 +2110,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"cloak:absorption",            { 60, 82, 82, 82, 43},
 	spell_cloak_absorb,        TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT(221),       500,     12,
+	&gsn_cloak_absorption,  SLOT(221),       500,     12,
 	"",                     "@@NThe @@lcloak@@N around your body fades.",
 	"@@NThe @@lcloak@@N around $n's body fades."
     },
@@ -2121,7 +2121,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"cloak:reflection",            { 48, 82, 82, 82, 82},
 	spell_cloak_reflect,        TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT(222),       500,     12,
+	&gsn_cloak_reflection,  SLOT(222),       500,     12,
 	"",                     "@@NThe @@lc@@el@@ro@@ya@@ak@@N around your body fades.",
 	"@@NThe @@lc@@el@@ro@@ya@@ak@@N around $n's body fades."
     },
@@ -2132,7 +2132,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"cloak:flaming",            { 70, 78, 82, 60, 82},
 	spell_cloak_flaming,        TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT(223),       750,     12,
+	&gsn_cloak_flaming,     SLOT(223),       750,     12,
 	"",                     "@@NThe @@ecloak@@N around your body fades.",
 	"@@NThe @@ecloak@@N around $n's body fades."
     },
@@ -2143,7 +2143,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, VAMP,
 	"cloak:darkness",            { 18, 13, 14, 14, 16},
 	spell_cloak_darkness,        TAR_CHAR_DEFENSIVE,     POS_STANDING,
-	NULL,                   SLOT(224),       45,     12,
+	&gsn_cloak_darkness,    SLOT(224),       45,     12,
 	"",                     "The @@dcloak@@N around your body fades.",
 	"@@NThe @@dcloak@@N around $n's body fades."
     },
@@ -2201,7 +2201,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"frost breath",         { 82, 82, 82, 82, 82 },
 	spell_frost_breath,     TAR_CHAR_OFFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(202),       0,      4,
+	&gsn_frost_breath,      SLOT(202),       0,      4,
 	"blast of frost",       "!Frost Breath!",
 	""
     },
@@ -2210,7 +2210,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	MORTAL, NORM,
 	"gas breath",           { 82, 82, 82, 82, 82 },
 	spell_gas_breath,       TAR_IGNORE,             POS_FIGHTING,
-	NULL,                   SLOT(203),       0,      4,
+	&gsn_gas_breath,        SLOT(203),       0,      4,
 	"blast of gas",         "!Gas Breath!",
 	""
     },
@@ -2228,7 +2228,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
         MORTAL, VAMP,	
         "blood leach",		{ 8, 4, 3, 4, 4 },
         spell_blood_leach,	TAR_CHAR_DEFENSIVE, 	POS_FIGHTING,
-        NULL, 			SLOT(540),	6,	12,
+        &gsn_blood_leach, 			SLOT(540),	6,	12,
         "",			"Your body feels stronger again.",
         ""
     },
@@ -2667,7 +2667,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
         REMORT, NORM,	
         "black hand",		{ 82, 82, 82, 7, 82 },
         spell_black_hand,	TAR_CHAR_OFFENSIVE, 	POS_STANDING,
-        NULL, 			SLOT(601),	50,	12,
+        &gsn_black_hand, 			SLOT(601),	50,	12,
         "",			"The hand dissolves from around your throat into nothingness.",
         ""
     },
@@ -2763,7 +2763,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"ethereal travel",               { 30, 82, 82, 40, 24 },
 	spell_ethereal,           TAR_IGNORE,     POS_STANDING,
-	NULL,                   SLOT(611),      250,    48,
+	&gsn_ethereal_travel,   SLOT(611),      250,    48,
 	"",                     "ETHEREAL TRAVEL!",
 	""
     },
@@ -2797,7 +2797,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"adrenaline bonus",                { 82, 82, 82,  82, 82 },
 	spell_null,             TAR_IGNORE,             POS_FIGHTING,
-	NULL,             SLOT( 612),        0,      0,
+	&gsn_adrenaline_bonus, SLOT( 612),        0,      0,
 	"",                     "!ADRENALINE BONUS!",
 	""
     },
@@ -2843,7 +2843,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
     	REMORT, NORM,
     	"healing light",		{ 82, 82, 25, 82, 33 },
     	spell_healing_light,		TAR_IGNORE,		POS_STANDING,
-    	NULL,			SLOT(616),	150,	12,
+    	&gsn_healing_light,			SLOT(616),	150,	12,
     	"",			"@@NThe @@mHealing Light@@N dissipates.",
     	""
     },
@@ -2861,7 +2861,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
     	REMORT, NORM,
     	"mana flare",		{ 18, 82, 82, 82, 22 },
     	spell_mana_flare,		TAR_IGNORE,		POS_STANDING,
-    	NULL,			SLOT(618),	80,	12,
+    	&gsn_mana_flare,			SLOT(618),	80,	12,
     	"",			"@@NThe @@eMana Flare@@N dissipates.",
     	""
     },
@@ -2891,7 +2891,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
     	REMORT, NORM,
     	"room dispel",		{ 22, 82, 33, 82, 82 },
     	spell_room_dispel,		TAR_IGNORE,		POS_STANDING,
-    	NULL,			SLOT(625),	120,	12,
+    	&gsn_room_dispel,			SLOT(625),	120,	12,
     	"",			"",
     	""
     },
@@ -3123,7 +3123,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"Retributive Strike",           { 72, 82, 82, 78, 82 },
 	spell_retri_strike,       TAR_IGNORE,             POS_FIGHTING,
-	NULL,                   SLOT(643),       800,     12,
+	&gsn_retributive_strike, SLOT(643),       800,     12,
 	"Retributive strike",           "!Retributive Strike!",
 	""
     },
@@ -3133,7 +3133,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"Lava Burst",            { 40, 82, 82, 82, 82 },
 	spell_lava_burst,        TAR_CHAR_OFFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(644),      350,     12,
+	&gsn_lava_burst,        SLOT(644),      350,     12,
 	"Lava Burst",            "!Lava Burst!",
 	""
     },
@@ -3142,7 +3142,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"fireshield",            { 80, 82, 82, 82, 82 },
 	spell_fireshield,        TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(645),       400,     12,
+	&gsn_fireshield,        SLOT(645),       400,     12,
 	"",                     "",
 	""
     },
@@ -3151,7 +3151,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"iceshield",            { 65, 82, 82, 82, 82 },
 	spell_iceshield,        TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(646),       350,     12,
+	&gsn_iceshield,         SLOT(646),       350,     12,
 	"",                     "",
 	""
     },
@@ -3160,7 +3160,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"shockshield",            { 55, 82, 82, 82, 82 },
 	spell_shockshield,        TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(647),       400,     12,
+	&gsn_shockshield,       SLOT(647),       400,     12,
 	"",                     "",
 	""
     },
@@ -3169,7 +3169,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"shadowshield",            { 82, 82, 82, 82, 82 },
 	spell_shadowshield,        TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(648),       400,     12,
+	&gsn_shadowshield,      SLOT(648),       400,     12,
 	"",                     "@@NThe @@rshield@@N shatters!!",
 	"@@NThe @@rshield@@N protecting $n shatters!!"
     },
@@ -3177,7 +3177,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"thoughtshield",            { 82, 82, 82, 82, 82 },
 	spell_thoughtshield,        TAR_CHAR_DEFENSIVE,     POS_FIGHTING,
-	NULL,                   SLOT(649),       400,     12,
+	&gsn_thoughtshield,     SLOT(649),       400,     12,
 	"",                     "@@NThe @@rshield@@N shatters!!",
 	"@@NThe @@rshield@@N protecting $n shatters!!"
     },
@@ -3186,7 +3186,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"Rage:wolven strength",                { 82, 82, 82,  82, 82 },
 	spell_null,             TAR_IGNORE,             POS_FIGHTING,
-	NULL,             SLOT( 650),        0,      0,
+	&gsn_rage_wolven_strength, SLOT( 650),        0,      0,
 	"",                     "",
 	""
     },
@@ -3195,7 +3195,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"Rage:sharpened claws",                { 82, 82, 82,  82, 82 },
 	spell_null,             TAR_IGNORE,             POS_FIGHTING,
-	NULL,             SLOT( 651),        0,      0,
+	&gsn_rage_sharpened_claws, SLOT( 651),        0,      0,
 	"",                     "",
 	""
     },
@@ -3203,7 +3203,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"Rage:disregard for pain",                { 82, 82, 82,  82, 82 },
 	spell_null,             TAR_IGNORE,             POS_FIGHTING,
-	NULL,             SLOT( 652),        0,      0,
+	&gsn_rage_disregard_for_pain, SLOT( 652),        0,      0,
 	"",                     "",
 	""
     },
@@ -3212,7 +3212,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
 	REMORT, NORM,
 	"Enraged",                { 82, 82, 82,  82, 82 },
 	spell_null,             TAR_IGNORE,             POS_FIGHTING,
-	NULL,             SLOT( 653),        0,      0,
+	&gsn_enraged,     SLOT( 653),        0,      0,
 	"",                     "",
 	""
     },
@@ -3382,7 +3382,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
       REMORT, NORM,
       "cloak:misery",            { 82, 80, 82, 73, 82},
       spell_cloak_misery,        TAR_CHAR_DEFENSIVE,     POS_STANDING,
-      NULL,                   SLOT(672),       550,     12,
+      &gsn_cloak_misery,      SLOT(672),       550,     12,
       "",                     "@@NThe @@Rcloak@@N around your body fades.",
       "@@NThe @@Rcloak@@N around $n's body fades."
     },
@@ -3430,7 +3430,7 @@ const   struct  skill_type      skill_table     [MAX_SKILL]     =
       MORTAL, NORM,
       "mystical focus",      { 55, 82, 82,  82, 82 },
       spell_mystical_focus,   TAR_CHAR_SELF,             POS_STANDING,
-      NULL,   SLOT( 676),        200,      10,
+      &gsn_mystical_focus, SLOT( 676),        200,      10,
       "",                     "Your lose your mystical focus.",
       "$N shakes his head, and seems less focused."
     },
@@ -140,6 +140,55 @@ sh_int			gsn_decapitate;
 sh_int      gsn_potency;
 sh_int      gsn_thaumatergy;
 
+/* Spells the code used to look up by name; see pgsn in skill_table. */
+sh_int			gsn_adrenaline_bonus;
+sh_int			gsn_armor;
+sh_int			gsn_black_hand;
+sh_int			gsn_bless;
+sh_int			gsn_blood_leach;
+sh_int			gsn_cloak_absorption;
+sh_int			gsn_cloak_darkness;
+sh_int			gsn_cloak_flaming;
+sh_int			gsn_cloak_misery;
+sh_int			gsn_cloak_reflection;
+sh_int			gsn_continual_light;
+sh_int			gsn_cure_blindness;
+sh_int			gsn_cure_critical;
+sh_int			gsn_cure_light;
+sh_int			gsn_cure_poison;
+sh_int			gsn_cure_serious;
+sh_int			gsn_detect_invis;
+sh_int			gsn_detect_magic;
+sh_int			gsn_detect_undead;
+sh_int			gsn_dispel_magic;
+sh_int			gsn_enraged;
+sh_int			gsn_ethereal_travel;
+sh_int			gsn_fireshield;
+sh_int			gsn_fly;
+sh_int			gsn_frost_breath;
+sh_int			gsn_gas_breath;
+sh_int			gsn_heal;
+sh_int			gsn_healing_light;
+sh_int			gsn_hellspawn;
+sh_int			gsn_iceshield;
+sh_int			gsn_infravision;
+sh_int			gsn_lava_burst;
+sh_int			gsn_mana_flare;
+sh_int			gsn_mystical_focus;
+sh_int			gsn_produce_food;
+sh_int			gsn_protection;
+sh_int			gsn_rage_disregard_for_pain;
+sh_int			gsn_rage_sharpened_claws;
+sh_int			gsn_rage_wolven_strength;
+sh_int			gsn_refresh;
+sh_int			gsn_retributive_strike;
+sh_int			gsn_room_dispel;
+sh_int			gsn_sanctuary;
+sh_int			gsn_shadowshield;
+sh_int			gsn_shockshield;
+sh_int			gsn_stone_skin;
+sh_int			gsn_thoughtshield;
+
 
 #ifdef TFS
 sh_int gsn_mana_sense;
@@ -246,7 +295,6 @@ int                     sAllocPerm;
 
 extern long MAX_STRING;
 void init_string_space(void);
-void boot_done(void);
 
 
 
@@ -398,14 +446,19 @@ void boot_db( bool fCopyOver )
 
     /*
      * Assign gsn's for skills which have them.
+     * A gsn given to two skills would quietly take the later one.
      */
     {
 	int sn;
 
 	for ( sn = 0; sn < MAX_SKILL; sn++ )
 	{
-	    if ( skill_table[sn].pgsn != 0 )
-		*skill_table[sn].pgsn = sn;
+	    if ( skill_table[sn].pgsn == 0 )
+		continue;
+	    if ( *skill_table[sn].pgsn != 0 )
+		bugf( "Boot_db: gsn for %s already set to %d.",
+		    skill_table[sn].name, *skill_table[sn].pgsn );
+	    *skill_table[sn].pgsn = sn;
 	}
     }
 
@@ -788,6 +841,7 @@ void load_helps( FILE *fp )
 	/* greeting text handled in comm.c now -S- */
 
 	LINK(pHelp, first_help, last_help, next, prev);
+	help_index_add( pHelp );
 /* MAG Mod */
 	GET_FREE(pList, build_free);
 	pList->data     = pHelp;
@@ -2142,6 +2196,7 @@ void reset_area( AREA_DATA *pArea )
     	OBJ_DATA *obj;
     	OBJ_DATA *obj_to;
       sh_int  num_allowed = 2;
+      int door_was;
 
     	switch ( pReset->command )
     	{
@@ -2358,6 +2413,7 @@ void reset_area( AREA_DATA *pArea )
 	    if ( ( pexit = pRoomIndex->exit[pReset->arg2] ) == NULL )
         break;
 
+	    door_was = pexit->exit_info & ( EX_CLOSED | EX_LOCKED );
 	    switch ( pReset->arg3 )
 	    {
 	    case 0:
@@ -2375,6 +2431,8 @@ void reset_area( AREA_DATA *pArea )
         SET_BIT(    pexit->exit_info, EX_LOCKED );
         break;
 	    }
+	    if ( ( pexit->exit_info & ( EX_CLOSED | EX_LOCKED ) ) != door_was )
+		hunt_doors_changed( );
 
 	    last = TRUE;
 	    break;
@@ -2541,7 +2599,7 @@ CHAR_DATA *create_mobile( MOB_INDEX_DATA *pMobIndex )
      */
     mob->next = NULL;
     mob->prev = NULL;
-    LINK(mob, first_char, last_char, next, prev);
+    char_to_list( mob );
     pMobIndex->count++;
 
 //  Create group data for mob
@@ -2825,6 +2883,8 @@ void free_char( CHAR_DATA *ch )
       ch->first_mpact = mpact->next;
       PUT_FREE(mpact, mpact_free);
     }
+    if ( ch->mpactnum > 0 )
+      UNLINK(ch, first_mpact_ch, last_mpact_ch, next_mpact_ch, prev_mpact_ch);
     
     for ( rch = first_char; rch; rch = rch->next )
     {
@@ -3217,11 +3277,7 @@ void *_getmem(int size, const char *caller, int log)
 {
   void *mem;
 
-  if ( !(mem = malloc(size)) )
-  {
-    fprintf(stderr, "Out of memory.\n");
-    raise(SIGSEGV);
-  }
+  mem = mem_get(size, caller, MEM_GETMEM);
   memset(mem, 0, size);
 
   if (log&&mem_log)
@@ -3419,7 +3475,7 @@ void do_memory( CHAR_DATA *ch, char *argument )
 
     if (!str_cmp(argument, "defrag"))
     {
-	send_to_char("Defragmenting SSM heap.", ch);
+	send_to_char("Sweeping the SSM heap.\n\r", ch);
 	log_f("SSM: %s called defrag_heap.", ch->name);
 	defrag_heap();
 	return;
@@ -3468,15 +3524,27 @@ void do_memory( CHAR_DATA *ch, char *argument )
 
   sprintf(buf, "Shared String Info:\n\r");
   send_to_char(buf, ch);
-  sprintf(buf, "Strings           %5ld strings of %7ld bytes (max %ld).\n\r",
-          nAllocString, sAllocString, MAX_STRING);
+  sprintf(buf, "Strings           %5ld strings of %7ld bytes (heap %ld in %d arena%s).\n\r",
+          nAllocString, sAllocString, MAX_STRING,
+          ssm_arenas, ssm_arenas == 1 ? "" : "s");
   send_to_char(buf, ch);
   sprintf(buf, "Overflow Strings  %5ld strings of %7ld bytes.\n\r",
           nOverFlowString, sOverFlowString);
   send_to_char(buf, ch);
+  sprintf(buf, "Interned dups     %5ld\n\r", nInternString);
+  send_to_char(buf, ch);
+  if (ssm_sweep_progress() >= 0)
+    sprintf(buf, "Heap sweeps       %5ld done, one %d%% through", ssm_sweeps,
+            ssm_sweep_progress());
+  else
+    sprintf(buf, "Heap sweeps       %5ld done", ssm_sweeps);
+  send_to_char(buf, ch);
+  sprintf(buf, ", %ld arena%s (%ld bytes) given back.\n\r",
+          ssm_released, ssm_released == 1 ? "" : "s", ssm_reclaimed);
+  send_to_char(buf, ch);
   if (Full)
   {
-    send_to_char("Shared String Heap is full, increase MAX_STRING.\n\r", ch);
+    send_to_char("Shared String Heap is full, increase SSM_MAX_ARENAS.\n\r", ch);
     sprintf(buf, "Overflow high-water-mark is %ld bytes.\n\r",
             hwOverFlow);
     send_to_char(buf, ch);
@@ -3485,6 +3553,7 @@ void do_memory( CHAR_DATA *ch, char *argument )
     sprintf( buf, "Perms   %5d blocks  of %7d bytes.\n\r",
 	nAllocPerm, sAllocPerm );
     send_to_char( buf, ch );
+    slab_report( ch );
 
     return;
 }
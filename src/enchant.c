@@ -773,7 +773,7 @@ void do_enchant(CHAR_DATA *ch, char * argument)
     if ( unique->extra_flags != new_extras )
       unique->extra_flags = new_extras;
     if ( unique->item_apply != new_apply )
-      unique->item_apply = new_apply;
+      set_item_apply( unique, new_apply, TRUE );
 
 
     ch->quest_points = ch->quest_points - qp_cost;
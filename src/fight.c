@@ -122,7 +122,7 @@ void violence_update( void )
 
    if ( !IS_NPC( ch ) && IS_WOLF( ch ) && IS_RAGED( ch ) )
    {
-     if ( !is_affected( ch, skill_lookup("Enraged" ) ) )
+     if ( !is_affected( ch, gsn_enraged ) )
        REMOVE_BIT( ch->pcdata->pflags, PFLAG_RAGED );
      ch->hit = ( UMIN( ch->max_hit, ( ch->hit + ch->max_hit /150 )));
       
@@ -185,7 +185,7 @@ void violence_update( void )
       && IS_SET( ch->act, ACT_SOLO ) 
       && ch->hit > 0 )
    {
-     if ( ( ch->hit < ch->max_hit *3 / 4 ) && ( ch->mana > mana_cost( ch, skill_lookup( "heal" ) ) ) )
+     if ( ( ch->hit < ch->max_hit *3 / 4 ) && ( ch->mana > mana_cost( ch, gsn_heal ) ) )
      {  
        do_cast( ch,  "heal self"  );
        has_cast = TRUE; 
@@ -212,7 +212,7 @@ void violence_update( void )
      {
        if ( IS_SET( ch->def, DEF_CURE_LIGHT ) )
        {
-         if ( ch->mana > mana_cost( ch, skill_lookup( "cure light" ) ) )
+         if ( ch->mana > mana_cost( ch, gsn_cure_light ) )
          {
            do_cast( ch, "\'cure light\' self" );
            has_cast = TRUE;
@@ -221,7 +221,7 @@ void violence_update( void )
        else
        if ( IS_SET( ch->def, DEF_CURE_SERIOUS ) )
        {
-         if ( ch->mana > mana_cost( ch, skill_lookup( "cure serious" ) ) )
+         if ( ch->mana > mana_cost( ch, gsn_cure_serious ) )
          {
            do_cast( ch, "\'cure serious\' self" );
            has_cast = TRUE;
@@ -230,7 +230,7 @@ void violence_update( void )
        else
        if ( IS_SET( ch->def, DEF_CURE_CRITIC ) )
        {
-         if ( ch->mana > mana_cost( ch, skill_lookup( "cure critical" ) ) )
+         if ( ch->mana > mana_cost( ch, gsn_cure_critical ) )
          {
            do_cast( ch, "\'cure critical\' self" );
            has_cast = TRUE;
@@ -239,7 +239,7 @@ void violence_update( void )
        else
        if ( IS_SET( ch->def, DEF_CURE_HEAL ) )
        {
-         if ( ch->mana > mana_cost( ch, skill_lookup( "heal" ) ) )
+         if ( ch->mana > mana_cost( ch, gsn_heal ) )
          {
            do_cast( ch, "heal self" );
            has_cast = TRUE;
@@ -267,24 +267,24 @@ void violence_update( void )
       && ( ch->fighting == NULL )  )
    {
       if (  ( IS_SET( ch->def, DEF_SHIELD_FIRE ) )
-         && ( !is_affected( ch, skill_lookup( "fireshield" ) )   )
-         && ( ch->mana > mana_cost( ch, skill_lookup( "fireshield" ) ) )   )
+         && ( !is_affected( ch, gsn_fireshield )   )
+         && ( ch->mana > mana_cost( ch, gsn_fireshield ) )   )
      {
        do_cast( ch, "fireshield" );
        has_cast = TRUE;
      }
      else
      if (  ( IS_SET( ch->def, DEF_SHIELD_ICE ) )
-        && ( !is_affected( ch, skill_lookup( "iceshield" ) )   )
-        && ( ch->mana > mana_cost( ch, skill_lookup( "iceshield" ) ) )   )
+        && ( !is_affected( ch, gsn_iceshield )   )
+        && ( ch->mana > mana_cost( ch, gsn_iceshield ) )   )
      {
        do_cast( ch, "iceshield" );
        has_cast = TRUE;
      }
      else
      if (  ( IS_SET( ch->def, DEF_SHIELD_SHOCK ) )
-        && ( !is_affected( ch, skill_lookup( "shockshield" ) )   )
-        && ( ch->mana > mana_cost( ch, skill_lookup( "shockshield" ) ) )   )
+        && ( !is_affected( ch, gsn_shockshield )   )
+        && ( ch->mana > mana_cost( ch, gsn_shockshield ) )   )
      {
        do_cast( ch, "shockshield" );
        has_cast = TRUE;
@@ -1031,12 +1031,12 @@ void damage( CHAR_DATA *ch, CHAR_DATA *victim, int dam, int dt )
         act( "@@NYour @@ecloak@@N is ripped to shreds!!!@@N", ch, NULL, victim, TO_VICT );
 
 
-        affect_strip( ch, skill_lookup( "iceshield" ) );
-        affect_strip( victim, skill_lookup( "iceshield" ) );
-        affect_strip( ch, skill_lookup( "fireshield" ) );
-        affect_strip( victim, skill_lookup( "fireshield" ) );
-        affect_strip( ch, skill_lookup( "cloak:flaming" ) );
-        affect_strip( victim, skill_lookup( "cloak:flaming" ) );
+        affect_strip( ch, gsn_iceshield );
+        affect_strip( victim, gsn_iceshield );
+        affect_strip( ch, gsn_fireshield );
+        affect_strip( victim, gsn_fireshield );
+        affect_strip( ch, gsn_cloak_flaming );
+        affect_strip( victim, gsn_cloak_flaming );
         if ( IS_SET( ch->affected_by, AFF_CLOAK_FLAMING ) )
           REMOVE_BIT( ch->affected_by, AFF_CLOAK_FLAMING );
         if ( IS_SET( victim->affected_by, AFF_CLOAK_FLAMING ) )
@@ -1055,8 +1055,7 @@ void damage( CHAR_DATA *ch, CHAR_DATA *victim, int dam, int dt )
             explosion->description = str_dup( "@@N A @@eFlaming @@NStaff of @@aIce@@N is supsended in mid air!" );
 
             elemental->level = 140;
-            free_string( elemental->name );
-            elemental->name = str_dup( ".hidden" );
+            char_rename( elemental, ".hidden" );
             free_string( elemental->short_descr );
             elemental->short_descr = str_dup( "@@NThe @@rConflict@@N of @@eFire @@Nand @@aIce@@N" );
             free_string( elemental->long_descr );
@@ -1068,7 +1067,7 @@ void damage( CHAR_DATA *ch, CHAR_DATA *victim, int dam, int dt )
             do_wear( elemental, bufz );
 
             if ( number_range( 0, 99 ) < 40 ) 
-              obj_cast_spell( skill_lookup( "Retributive strike" ), 100, elemental, NULL, explosion );
+              obj_cast_spell( gsn_retributive_strike, 100, elemental, NULL, explosion );
             else
             {
               CREF( rch_next, CHAR_NEXTROOM );
@@ -1079,9 +1078,9 @@ void damage( CHAR_DATA *ch, CHAR_DATA *victim, int dam, int dt )
                   continue;
                 send_to_char( "\n\r@@NYou are @@ablasted@@N by the @@econflagration@@N!\n\r", rch );
                 if ( number_range( 0, 99 ) < 50 ) 
-                 obj_cast_spell( skill_lookup( "frost breath" ), 120, elemental, rch, explosion );
+                 obj_cast_spell( gsn_frost_breath, 120, elemental, rch, explosion );
                 else
-                  obj_cast_spell( skill_lookup( "lava burst" ), 120, elemental, rch, explosion );
+                  obj_cast_spell( gsn_lava_burst, 120, elemental, rch, explosion );
               }
               if (  ( elemental->fighting != NULL )
                  && ( IS_NPC( elemental->fighting ) )  )
@@ -1120,7 +1119,7 @@ void damage( CHAR_DATA *ch, CHAR_DATA *victim, int dam, int dt )
       }
  
     }
-    if (  ( is_affected( victim, skill_lookup( "cloak:misery" ) ) )
+    if (  ( is_affected( victim, gsn_cloak_misery ) )
        && ( ch != victim ) 
        && ( number_range( 0, 99 ) < 35 )  
      /*  && ( dt == TYPE_HIT ) */  )
@@ -1137,7 +1136,7 @@ void damage( CHAR_DATA *ch, CHAR_DATA *victim, int dam, int dt )
         act( "@@NYour @@dcloak@@N flares, and shrouds $N with @@dmisery@@N!!!", victim, NULL, ch, TO_CHAR );
       if ( TRUE )
       {
-        af.type      = skill_lookup( "curse" );
+        af.type      = gsn_curse;
         af.duration  = 1;
         af.location  = APPLY_HITROLL;
         af.modifier  = -1;
@@ -3957,7 +3956,7 @@ void do_dirt( CHAR_DATA *ch, char *argument )
        act( "$n kicks dirt in your eyes!",  ch, NULL, victim, TO_VICT    );
        act( "$n kicks dirt at $N's eyes!",  ch, NULL, victim, TO_NOTVICT );
 
-       af.type      = skill_lookup( "blindness" );
+       af.type      = gsn_blindness;
        af.location  = APPLY_HITROLL;
        af.modifier  = -2;
        af.duration  = 1;
@@ -5435,7 +5434,7 @@ AFFECT_DATA af;
    if ( damage > 200 && ch->pcdata->learned[gsn_adrenaline] > 70 )
    {
       
-     af.type      = skill_lookup( "adrenaline bonus" );
+     af.type      = gsn_adrenaline_bonus;
      af.duration  = 1;
      af.location  = APPLY_DAMROLL;
      af.modifier  = 1;
@@ -5582,10 +5581,10 @@ void do_rage( CHAR_DATA *ch, char *argument )
 
      int	duration;
       
-     af1.type      = skill_lookup( "Rage:sharpened claws" );
-     af2.type      = skill_lookup( "Rage:wolven strength" );
-     af3.type      = skill_lookup( "Rage:disregard for pain" );
-     af4.type	   = skill_lookup( "Enraged" );
+     af1.type      = gsn_rage_sharpened_claws;
+     af2.type      = gsn_rage_wolven_strength;
+     af3.type      = gsn_rage_disregard_for_pain;
+     af4.type	   = gsn_enraged;
 
      if ( !str_cmp( arg, "FORCE" ) )
      {
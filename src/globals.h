@@ -110,6 +110,55 @@ extern  sh_int  gsn_decapitate;
 extern  sh_int      gsn_potency;
 extern  sh_int      gsn_thaumatergy;
 
+/* Spells the code used to look up by name; see pgsn in skill_table. */
+extern  sh_int  gsn_adrenaline_bonus;
+extern  sh_int  gsn_armor;
+extern  sh_int  gsn_black_hand;
+extern  sh_int  gsn_bless;
+extern  sh_int  gsn_blood_leach;
+extern  sh_int  gsn_cloak_absorption;
+extern  sh_int  gsn_cloak_darkness;
+extern  sh_int  gsn_cloak_flaming;
+extern  sh_int  gsn_cloak_misery;
+extern  sh_int  gsn_cloak_reflection;
+extern  sh_int  gsn_continual_light;
+extern  sh_int  gsn_cure_blindness;
+extern  sh_int  gsn_cure_critical;
+extern  sh_int  gsn_cure_light;
+extern  sh_int  gsn_cure_poison;
+extern  sh_int  gsn_cure_serious;
+extern  sh_int  gsn_detect_invis;
+extern  sh_int  gsn_detect_magic;
+extern  sh_int  gsn_detect_undead;
+extern  sh_int  gsn_dispel_magic;
+extern  sh_int  gsn_enraged;
+extern  sh_int  gsn_ethereal_travel;
+extern  sh_int  gsn_fireshield;
+extern  sh_int  gsn_fly;
+extern  sh_int  gsn_frost_breath;
+extern  sh_int  gsn_gas_breath;
+extern  sh_int  gsn_heal;
+extern  sh_int  gsn_healing_light;
+extern  sh_int  gsn_hellspawn;
+extern  sh_int  gsn_iceshield;
+extern  sh_int  gsn_infravision;
+extern  sh_int  gsn_lava_burst;
+extern  sh_int  gsn_mana_flare;
+extern  sh_int  gsn_mystical_focus;
+extern  sh_int  gsn_produce_food;
+extern  sh_int  gsn_protection;
+extern  sh_int  gsn_rage_disregard_for_pain;
+extern  sh_int  gsn_rage_sharpened_claws;
+extern  sh_int  gsn_rage_wolven_strength;
+extern  sh_int  gsn_refresh;
+extern  sh_int  gsn_retributive_strike;
+extern  sh_int  gsn_room_dispel;
+extern  sh_int  gsn_sanctuary;
+extern  sh_int  gsn_shadowshield;
+extern  sh_int  gsn_shockshield;
+extern  sh_int  gsn_stone_skin;
+extern  sh_int  gsn_thoughtshield;
+
 
 #ifdef TFS
 extern sh_int gsn_mana_sense;
@@ -586,6 +635,13 @@ DECLARE_DO_FUN( do_mapper );
 DECLARE_DO_FUN( do_mgive );
 DECLARE_DO_FUN( do_email );
 DECLARE_DO_FUN( do_findreset );
+DECLARE_DO_FUN( do_dnscache );
+DECLARE_DO_FUN( do_schedstat );
+DECLARE_DO_FUN( do_pulsestat );
+DECLARE_DO_FUN( do_cmdstat );
+DECLARE_DO_FUN( do_memstat );
+DECLARE_DO_FUN( do_huntstat );
+DECLARE_DO_FUN( do_colourbench );
 
 
 /*
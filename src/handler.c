@@ -55,6 +55,7 @@ extern COUNCIL_DATA super_councils[MAX_SUPER];
  * Local functions.
  */
 void    affect_modify   args( ( CHAR_DATA *ch, AFFECT_DATA *paf, bool fAdd ) );
+static void name_index_remove args( ( CHAR_DATA *ch ) );
 
 /*
  * Updated pointer referencing, curtesy of Spectrum, from Beyond the Veil
@@ -78,6 +79,9 @@ void obj_reference(struct obj_ref_type *ref)
   obj_ref_list=ref;
 }
 
+/*
+ * OUREF pops the top of the stack itself; this is for the rest.
+ */
 void obj_unreference(OBJ_DATA **var)
 {
   struct obj_ref_type *p, *last;
@@ -93,6 +97,10 @@ void obj_unreference(OBJ_DATA **var)
     return;
   }
 
+  if (last)
+    bugf("obj_unreference: %s released under %s", p->caller,
+         obj_ref_list->caller);
+
   p->inuse=FALSE;
 
   if (!last)
@@ -116,6 +124,9 @@ void char_reference(struct char_ref_type *ref)
   char_ref_list=ref;
 }
 
+/*
+ * CUREF pops the top of the stack itself; this is for the rest.
+ */
 void char_unreference(CHAR_DATA **var)
 {
   struct char_ref_type *p, *last;
@@ -131,6 +142,10 @@ void char_unreference(CHAR_DATA **var)
     return;
   }
 
+  if (last)
+    bugf("char_unreference: %s released under %s", p->caller,
+         char_ref_list->caller);
+
   p->inuse=FALSE;
 
   if (!last)
@@ -384,7 +399,7 @@ void affect_modify( CHAR_DATA *ch, AFFECT_DATA *paf, bool fAdd )
       return;
     }
 
-    if ( paf->type == skill_lookup( "Enraged" )  )
+    if ( paf->type == gsn_enraged  )
       REMOVE_BIT( ch->pcdata->pflags, PFLAG_RAGED );
 
     switch ( paf->location )
@@ -604,7 +619,7 @@ void affect_to_char( CHAR_DATA *ch, AFFECT_DATA *paf )
 
     affect_modify( ch, paf_new, TRUE );
 
-    if ( paf_new->type == skill_lookup( "Enraged" ) )
+    if ( paf_new->type == gsn_enraged )
       if ( !IS_NPC( ch ) && IS_WOLF( ch ) )
         SET_BIT( ch->pcdata->pflags, PFLAG_RAGED );
 
@@ -634,15 +649,15 @@ void affect_remove( CHAR_DATA *ch, AFFECT_DATA *paf )
     affect_modify( ch, paf, FALSE );
     shield_type = SHIELD_NONE;
 
-    if ( paf->type == skill_lookup( "fireshield" ) )
+    if ( paf->type == gsn_fireshield )
       shield_type = FLAME_SHIELD;
-    else if ( paf->type == skill_lookup( "iceshield"  ) )
+    else if ( paf->type == gsn_iceshield )
       shield_type = ICE_SHIELD;
-    else if ( paf->type == skill_lookup( "shockshield" ) )
+    else if ( paf->type == gsn_shockshield )
       shield_type = SHOCK_SHIELD;
-    else if ( paf->type == skill_lookup( "shadowshield" ) )
+    else if ( paf->type == gsn_shadowshield )
       shield_type = SHADOW_SHIELD;
-    else if ( paf->type == skill_lookup( "thoughtshield" ) )   
+    else if ( paf->type == gsn_thoughtshield )   
       shield_type = PSI_SHIELD;
     if ( shield_type > SHIELD_NONE )
     {
@@ -755,6 +770,131 @@ OBJ_DATA *get_light_char( CHAR_DATA *ch )
     return NULL;
 }
 
+/*
+ * Besides first_person, a room keeps its players and its aggressive mobs
+ * on lists of their own, and a room with some of each is on the hot room
+ * list, which is all aggr_update looks at.  A char remembers which list
+ * it went on, as its flags may have changed by the time it leaves.
+ */
+#define ROOM_KIND_NONE	0
+#define ROOM_KIND_PC	1
+#define ROOM_KIND_AGGR	2
+
+static void room_kind_add( CHAR_DATA *ch, ROOM_INDEX_DATA *room )
+{
+    bool was_hot = ( room->first_pc != NULL && room->first_aggr != NULL );
+
+    if ( !IS_NPC(ch) )
+    {
+	ch->room_kind = ROOM_KIND_PC;
+	LINK(ch, room->first_pc, room->last_pc, next_kind, prev_kind);
+    }
+    else if ( IS_SET(ch->act, ACT_AGGRESSIVE) )
+    {
+	/* same order as first_person, newest first */
+	ch->room_kind = ROOM_KIND_AGGR;
+	TOPLINK(ch, room->first_aggr, room->last_aggr, next_kind, prev_kind);
+    }
+    else
+    {
+	ch->room_kind = ROOM_KIND_NONE;
+	return;
+    }
+
+    if ( !was_hot && room->first_pc != NULL && room->first_aggr != NULL )
+	LINK(room, first_hot_room, last_hot_room, next_hot, prev_hot);
+    return;
+}
+
+static void room_kind_remove( CHAR_DATA *ch, ROOM_INDEX_DATA *room )
+{
+    bool was_hot = ( room->first_pc != NULL && room->first_aggr != NULL );
+
+    switch ( ch->room_kind )
+    {
+    case ROOM_KIND_PC:
+	UNLINK(ch, room->first_pc, room->last_pc, next_kind, prev_kind);
+	break;
+    case ROOM_KIND_AGGR:
+	UNLINK(ch, room->first_aggr, room->last_aggr, next_kind, prev_kind);
+	break;
+    }
+    ch->room_kind = ROOM_KIND_NONE;
+    ch->next_kind = NULL;
+    ch->prev_kind = NULL;
+
+    if ( was_hot && ( room->first_pc == NULL || room->first_aggr == NULL ) )
+	UNLINK(room, first_hot_room, last_hot_room, next_hot, prev_hot);
+    return;
+}
+
+/*
+ * Put ch back on the right list after its act flags change where it
+ * stands: switching into a mob makes it a player, returning makes it a
+ * mob again.
+ */
+void room_kind_update( CHAR_DATA *ch )
+{
+    if ( ch->in_room == NULL )
+	return;
+    room_kind_remove( ch, ch->in_room );
+    room_kind_add( ch, ch->in_room );
+    return;
+}
+
+/*
+ * Check everyone is on the list they should be, and the hot rooms are
+ * the ones with someone to fight.  For scheck.
+ */
+int room_kind_check( void )
+{
+    CHAR_DATA *ch;
+    CHAR_DATA *kch;
+    ROOM_INDEX_DATA *room;
+    int bad = 0;
+
+    for ( ch = first_char; ch != NULL; ch = ch->next )
+    {
+	if ( ( room = ch->in_room ) == NULL )
+	    continue;
+	if ( ch->room_kind == ROOM_KIND_NONE )
+	{
+	    if ( !IS_NPC(ch) || IS_SET(ch->act, ACT_AGGRESSIVE) )
+	    {
+		bugf( "room_kind_check: %s is on no list in room %d.",
+		    NAME(ch), room->vnum );
+		bad++;
+	    }
+	    continue;
+	}
+	for ( kch = ( ch->room_kind == ROOM_KIND_PC ? room->first_pc
+						    : room->first_aggr );
+	      kch != NULL && kch != ch; kch = kch->next_kind )
+	    ;
+	if ( kch == NULL )
+	{
+	    bugf( "room_kind_check: %s is missing from room %d's list.",
+		NAME(ch), room->vnum );
+	    bad++;
+	}
+	else if ( room->first_pc != NULL && room->first_aggr != NULL
+	     &&   room->prev_hot == NULL && first_hot_room != room )
+	{
+	    bugf( "room_kind_check: room %d should be hot.", room->vnum );
+	    bad++;
+	}
+    }
+
+    for ( room = first_hot_room; room != NULL; room = room->next_hot )
+	if ( room->first_pc == NULL || room->first_aggr == NULL )
+	{
+	    bugf( "room_kind_check: room %d is hot with nobody to fight.",
+		room->vnum );
+	    bad++;
+	}
+    return bad;
+}
+
 /*
  * Move a char out of a room.
  */
@@ -781,6 +921,7 @@ void char_from_room( CHAR_DATA *ch )
 
     UNLINK(ch, ch->in_room->first_person, ch->in_room->last_person,
            next_in_room, prev_in_room);
+    room_kind_remove(ch, ch->in_room);
 
     ch->in_room      = NULL;
     ch->next_in_room = NULL;
@@ -824,6 +965,7 @@ void char_to_room( CHAR_DATA *ch, ROOM_INDEX_DATA *pRoomIndex )
     else
       LINK(ch, pRoomIndex->first_person, pRoomIndex->last_person,
            next_in_room, prev_in_room);
+    room_kind_add(ch, pRoomIndex);
 
     if ( !IS_NPC(ch) )
     	++ch->in_room->area->nplayer;
@@ -898,7 +1040,7 @@ void char_to_room( CHAR_DATA *ch, ROOM_INDEX_DATA *pRoomIndex )
              }
           if ( !saves_spell( caster_level, ch ) )
           {
-            af.type      = skill_lookup( "poison" );
+            af.type      = gsn_poison;
             af.duration  = 12 + (caster_level/10);
             af.location  = APPLY_STR;
             af.modifier  = -2;
@@ -969,6 +1111,13 @@ void obj_to_char( OBJ_DATA *obj, CHAR_DATA *ch )
     obj->prev_in_room = NULL;
     ch->carry_number    += get_obj_number( obj );
     ch->carry_weight    += get_obj_weight( obj );
+    if ( obj->wear_loc != WEAR_NONE )		/* loaded worn, see save.c */
+    {
+	SET_BIT( ch->worn_apply, obj->item_apply );
+	if ( obj->wear_loc >= 0 && obj->wear_loc < MAX_WEAR
+	&&   ch->worn[obj->wear_loc] == NULL )
+	    ch->worn[obj->wear_loc] = obj;
+    }
 
     if ( AI_MOB( ch ) )
     {
@@ -1098,7 +1247,7 @@ int apply_ac( OBJ_DATA *obj, int iWear )
 /*
  * Find a piece of eq on a character.
  */
-OBJ_DATA *get_eq_char( CHAR_DATA *ch, int iWear )
+static OBJ_DATA *worn_find( CHAR_DATA *ch, int iWear )
 {
     OBJ_DATA *obj;
 
@@ -1111,6 +1260,58 @@ OBJ_DATA *get_eq_char( CHAR_DATA *ch, int iWear )
     return NULL;
 }
 
+/*
+ * ch->worn[] holds what get_eq_char used to find by walking everything
+ * ch carries: the first object in the carry list worn at each slot.
+ * equip_char, obj_to_char and unequip_char keep it.  'scheck worn'
+ * turns on worn_debug, which checks every call against the walk.
+ */
+bool worn_debug = FALSE;
+
+OBJ_DATA *get_eq_char( CHAR_DATA *ch, int iWear )
+{
+    if ( iWear < 0 || iWear >= MAX_WEAR )
+	return worn_find( ch, iWear );
+
+    if ( worn_debug && ch->worn[iWear] != worn_find( ch, iWear ) )
+	bugf( "get_eq_char: %s has the wrong thing at slot %d.",
+	    NAME( ch ), iWear );
+
+    return ch->worn[iWear];
+}
+
+/*
+ * Check everyone's worn[] and worn_apply, returning how many are out.
+ */
+int worn_check( void )
+{
+    CHAR_DATA *ch;
+    int worn_apply;
+    int bad = 0;
+    int iWear;
+
+    for ( ch = first_char; ch != NULL; ch = ch->next )
+    {
+	for ( iWear = 0; iWear < MAX_WEAR; iWear++ )
+	    if ( ch->worn[iWear] != worn_find( ch, iWear ) )
+	    {
+		bugf( "worn_check: %s has the wrong thing at slot %d.",
+		    NAME( ch ), iWear );
+		bad++;
+	    }
+
+	worn_apply = ch->worn_apply;
+	char_apply_update( ch );
+	if ( worn_apply != ch->worn_apply )
+	{
+	    bugf( "worn_check: %s had worn_apply %d, not %d.",
+		NAME( ch ), worn_apply, ch->worn_apply );
+	    bad++;
+	}
+    }
+    return bad;
+}
+
 
 
 /*
@@ -1157,6 +1358,9 @@ void equip_char( CHAR_DATA *ch, OBJ_DATA *obj, int iWear )
 
     ch->armor           -= apply_ac( obj, iWear );
     obj->wear_loc        = iWear;
+    SET_BIT( ch->worn_apply, obj->item_apply );
+    if ( iWear >= 0 && iWear < MAX_WEAR )	/* doubled up: whichever's first */
+	ch->worn[iWear] = ch->worn[iWear] == NULL ? obj : worn_find( ch, iWear );
 
     
     for ( paf = obj->first_apply; paf != NULL; paf = paf->next )
@@ -1235,6 +1439,7 @@ void equip_char( CHAR_DATA *ch, OBJ_DATA *obj, int iWear )
 void unequip_char( CHAR_DATA *ch, OBJ_DATA *obj )
 {
     AFFECT_DATA *paf;
+    int iWear = obj->wear_loc;
 
     if ( obj->wear_loc == WEAR_NONE )
     {
@@ -1249,6 +1454,9 @@ void unequip_char( CHAR_DATA *ch, OBJ_DATA *obj )
 
     ch->armor           += apply_ac( obj, obj->wear_loc );
     obj->wear_loc        = -1;
+    char_apply_update( ch );
+    if ( iWear >= 0 && iWear < MAX_WEAR && ch->worn[iWear] == obj )
+	ch->worn[iWear] = worn_find( ch, iWear );
 
     /*
     for ( paf = obj->pIndexData->first_apply; paf != NULL; paf = paf->next )
@@ -1670,6 +1878,12 @@ void extract_char( CHAR_DATA *ch, bool fPull )
       case CHAR_NEXTROOM:
         *ref->var=ch->next_in_room;
         break;
+      case CHAR_NEXTKIND:
+        *ref->var=ch->next_kind;
+        break;
+      case CHAR_NEXTMPACT:
+        *ref->var=ch->next_mpact_ch;
+        break;
       case CHAR_NULL:
         *ref->var=NULL;
         break;
@@ -1822,6 +2036,7 @@ void extract_char( CHAR_DATA *ch, bool fPull )
         }
       }
     }
+    name_index_remove( ch );
     UNLINK(ch, first_char, last_char, next, prev);
     if ( ch->desc )
 	ch->desc->character = NULL;
@@ -1907,22 +2122,183 @@ CHAR_DATA *get_char_room( CHAR_DATA *ch, char *argument )
 
 
 /*
- * Find a char in the world.
+ * Name index.  Each word of each name on first_char has a NAME_KEY in
+ * the name_hash bucket for that word, so a world lookup only looks at
+ * characters who might have the word; is_name() still has the last say.
+ * A bucket is kept in first_char order, so "2.guard" counts the same as
+ * walking the whole list did.  Characters go on the list through
+ * char_to_list(), change their names through char_rename(), and come
+ * out of the index in extract_char().
  */
-CHAR_DATA *get_char_world( CHAR_DATA *ch, char *argument )
+struct name_key
 {
-    char arg[MAX_INPUT_LENGTH];
-    CHAR_DATA *wch;
-    int number;
-    int count;
+    bool	is_free;
+    NAME_KEY *	next;		/* in the bucket */
+    NAME_KEY *	prev;
+    NAME_KEY *	next_key;	/* this character's next word */
+    CHAR_DATA *	ch;
+    unsigned int hash;
+};
 
-    if ( ( wch = get_char_room( ch, argument ) ) != NULL )
-	return wch;
+static struct
+{
+    NAME_KEY *	first;
+    NAME_KEY *	last;
+} name_hash[NAME_HASH];
 
-    number = number_argument( argument, arg );
-    count  = 0;
-    for ( wch = first_char; wch != NULL ; wch = wch->next )
+static long name_order;
+
+static unsigned int name_hash_word( const char *word )
+{
+    unsigned int hash = 0;
+
+    for ( ; *word != '\0'; word++ )
+	hash = hash * 31 + (unsigned char) LOWER( *word );
+    return hash;
+}
+
+static void name_index_add( CHAR_DATA *ch )
+{
+    char word[MAX_INPUT_LENGTH];
+    NAME_KEY *key;
+    NAME_KEY *at;
+    char *list;
+    unsigned int hash;
+    int b;
+
+    for ( list = ch->name; ; )
+    {
+	list = one_argument( list, word );
+	if ( word[0] == '\0' )
+	    break;
+
+	hash = name_hash_word( word );
+	for ( key = ch->name_keys; key != NULL; key = key->next_key )
+	    if ( key->hash == hash )
+		break;
+	if ( key != NULL )
+	    continue;		/* one key per word is enough */
+
+	key = getmem( sizeof( *key ) );
+	key->is_free  = FALSE;
+	key->ch       = ch;
+	key->hash     = hash;
+	key->next_key = ch->name_keys;
+	ch->name_keys = key;
+
+	/* almost always the newest, so at the end */
+	b = hash % NAME_HASH;
+	for ( at = name_hash[b].last; at != NULL; at = at->prev )
+	    if ( at->ch->list_order < ch->list_order )
+		break;
+	if ( at == NULL )
+	    TOPLINK( key, name_hash[b].first, name_hash[b].last, next, prev );
+	else
+	    LINK_AFTER( key, at, name_hash[b].first, name_hash[b].last,
+		next, prev );
+    }
+    return;
+}
+
+static void name_index_remove( CHAR_DATA *ch )
+{
+    NAME_KEY *key;
+    int b;
+
+    while ( ( key = ch->name_keys ) != NULL )
+    {
+	ch->name_keys = key->next_key;
+	b = key->hash % NAME_HASH;
+	UNLINK( key, name_hash[b].first, name_hash[b].last, next, prev );
+	dispose( key, sizeof( *key ) );
+    }
+    return;
+}
+
+/*
+ * Put a new character on first_char.
+ */
+void char_to_list( CHAR_DATA *ch )
+{
+    LINK( ch, first_char, last_char, next, prev );
+    ch->list_order = ++name_order;
+    name_index_add( ch );
+    return;
+}
+
+/*
+ * Give ch a new name.
+ */
+void char_rename( CHAR_DATA *ch, char *name )
+{
+    name_index_remove( ch );
+    free_string( ch->name );
+    ch->name = str_dup( name );
+    if ( ch->list_order != 0 )
+	name_index_add( ch );
+    return;
+}
+
+/*
+ * Check everyone on first_char can be found by each word of their name,
+ * returning how many words can't.
+ */
+int name_check( void )
+{
+    char word[MAX_INPUT_LENGTH];
+    CHAR_DATA *ch;
+    NAME_KEY *key;
+    char *list;
+    unsigned int hash;
+    int bad = 0;
+
+    for ( ch = first_char; ch != NULL; ch = ch->next )
+	for ( list = ch->name; ; )
+	{
+	    list = one_argument( list, word );
+	    if ( word[0] == '\0' )
+		break;
+	    hash = name_hash_word( word );
+	    for ( key = name_hash[hash % NAME_HASH].first; key != NULL;
+		  key = key->next )
+		if ( key->ch == ch && key->hash == hash )
+		    break;
+	    if ( key == NULL )
+	    {
+		bugf( "name_check: %s can't be found as '%s'.",
+		    NAME( ch ), word );
+		bad++;
+	    }
+	}
+    return bad;
+}
+
+#define NAME_WORLD	0
+#define NAME_AREA	1
+#define NAME_PLAYER	2
+
+/*
+ * The number'th character ch can see with arg in their name, in the
+ * whole world, ch's area, or among players.
+ */
+static CHAR_DATA *name_lookup( CHAR_DATA *ch, char *arg, int number,
+			       int where )
+{
+    NAME_KEY *key;
+    CHAR_DATA *wch;
+    unsigned int hash;
+    int count = 0;
+
+    hash = name_hash_word( arg );
+    for ( key = name_hash[hash % NAME_HASH].first; key != NULL; key = key->next )
     {
+	if ( key->hash != hash )
+	    continue;
+	wch = key->ch;
+	if ( where == NAME_PLAYER && IS_NPC( wch ) )
+	    continue;
+	if ( where == NAME_AREA && wch->in_room->area != ch->in_room->area )
+	    continue;
 	if ( !can_see( ch, wch ) || !is_name( arg, wch->name ) )
 	    continue;
 	if ( ++count == number )
@@ -1932,28 +2308,45 @@ CHAR_DATA *get_char_world( CHAR_DATA *ch, char *argument )
     return NULL;
 }
 
+/*
+ * Find a char in the world.
+ */
+CHAR_DATA *get_char_world( CHAR_DATA *ch, char *argument )
+{
+    char arg[MAX_INPUT_LENGTH];
+    CHAR_DATA *wch;
+    int number;
+
+    if ( ( wch = get_char_room( ch, argument ) ) != NULL )
+	return wch;
+
+    number = number_argument( argument, arg );
+    return name_lookup( ch, arg, number, NAME_WORLD );
+}
+
 CHAR_DATA *get_char_area( CHAR_DATA *ch, char *argument )
 {
   char arg[MAX_INPUT_LENGTH];
   CHAR_DATA *ach;
   int number;
-  int count;
 
   if ( ( ach = get_char_room( ch, argument ) ) != NULL )
     return ach;
 
   number = number_argument( argument, arg );
-  count  = 0;
-  for ( ach = first_char; ach != NULL ; ach = ach->next )
-    {
-      if ( ach->in_room->area != ch->in_room->area
-	  || !can_see( ch, ach ) || !is_name( arg, ach->name ) )
-	continue;
-      if ( ++count == number )
-	return ach;
-    }
+  return name_lookup( ch, arg, number, NAME_AREA );
+}
 
-  return NULL;
+/*
+ * Find a player in the world, passing over any mobs of the same name.
+ */
+CHAR_DATA *get_player_world( CHAR_DATA *ch, char *argument )
+{
+    char arg[MAX_INPUT_LENGTH];
+    int number;
+
+    number = number_argument( argument, arg );
+    return name_lookup( ch, arg, number, NAME_PLAYER );
 }
 
 /* Used mainly for Imtlset ---Flar */
@@ -2443,14 +2836,17 @@ void notify( char * message, int lv )
 
   DESCRIPTOR_DATA *d;
   char   buf[MAX_STRING_LENGTH];
+  OUT_CAST cast;
 
   sprintf( buf, "[NOTE]: %s\n\r", message );
+  cast_init( &cast, buf );
   for ( d = first_desc; d; d = d->next )
     if ( ( d->connected == CON_PLAYING ) 
         && (d->character->level >=lv) 
         && !IS_NPC(d->character) 
         && !IS_SET( d->character->deaf, CHANNEL_NOTIFY ) )
-      send_to_char( buf, d->character );    
+      cast_to( &cast, d );
+  cast_done( &cast );
   return;
 }
 
@@ -2458,13 +2854,16 @@ void auction( char * message )
 {
   DESCRIPTOR_DATA *d;
   char   buf[MAX_STRING_LENGTH];
+  OUT_CAST cast;
 
   sprintf( buf, "[AUCTION]: %s\n\r", message );
+  cast_init( &cast, buf );
   for ( d = first_desc; d; d = d->next )
     if ( ( d->connected == CON_PLAYING ) 
        && !IS_NPC(d->character) 
        && !IS_SET( d->character->deaf, CHANNEL_AUCTION ) )
-      send_to_char( buf, d->character );    
+      cast_to( &cast, d );
+  cast_done( &cast );
   return;
 }
 
@@ -2477,8 +2876,16 @@ void info( char * message, int lv )
   * Used mainly to send level gain, death info, etc to mortals.
   * - Stephen
   */
+  /* One broadcast for each info colour players have picked. */
   DESCRIPTOR_DATA *d;
   char   buf[MAX_STRING_LENGTH];
+  char   text[OUT_CAST_MODES][MAX_STRING_LENGTH];
+  const char *pre[OUT_CAST_MODES];
+  const char *post[OUT_CAST_MODES];
+  OUT_CAST cast[OUT_CAST_MODES];
+  const char *col, *normal;
+  int top = 0;
+  int i;
 
   for ( d = first_desc; d; d = d->next )
     if ( ( d->connected == CON_PLAYING ) 
@@ -2486,11 +2893,30 @@ void info( char * message, int lv )
        && !IS_NPC(d->character) 
        && !IS_SET( d->character->deaf, CHANNEL_INFO ) )
     {
-      sprintf( buf, "%s[INFO]: %s%s\n\r", 
-               color_string( d->character, "info" ), message,
-               color_string( d->character, "normal" ) );
-      send_to_char( buf, d->character );    
+      col    = color_string( d->character, "info" );
+      normal = color_string( d->character, "normal" );
+      for ( i = 0; i < top; i++ )
+        if ( pre[i] == col && post[i] == normal )
+          break;
+      if ( i == top && top < OUT_CAST_MODES )
+      {
+        sprintf( text[i], "%s[INFO]: %s%s\n\r", col, message, normal );
+        cast_init( &cast[i], text[i] );
+        pre[i]  = col;
+        post[i] = normal;
+        top++;
+      }
+
+      if ( i < top )
+        cast_to( &cast[i], d );
+      else if ( !output_shed( d ) )
+      {
+        sprintf( buf, "%s[INFO]: %s%s\n\r", col, message, normal );
+        send_to_char( buf, d->character );    
+      }
     }
+  for ( i = 0; i < top; i++ )
+    cast_done( &cast[i] );
   return;
 }
 
@@ -2501,34 +2927,53 @@ void log_chan( const char *message, int lv )
     * Level is used to determine WHO gets the message... */
    DESCRIPTOR_DATA *d;
    char buf[MAX_STRING_LENGTH];
+   OUT_CAST cast;
    
    sprintf( buf, "[LOG]: %s\n\r", message );
+   cast_init( &cast, buf );
    for ( d = first_desc; d; d = d->next )
       if ( ( d->connected == CON_PLAYING )
           && ( get_trust( d->character ) == MAX_LEVEL )
           && ( !IS_NPC( d->character ) )
           && ( d->character->level >= lv )
           && ( !IS_SET( d->character->deaf, CHANNEL_LOG ) ) )
-        send_to_char( buf, d->character );
+        cast_to( &cast, d );
+   cast_done( &cast );
    return;
 }
 
 
 
-bool item_has_apply( CHAR_DATA *ch, int bit )
+/*
+ * item_has_apply (utils.h) used to walk everything ch carried to see
+ * if anything worn had the ITEM_APPLY bit.  Now ch->worn_apply keeps
+ * the bits of all that's worn: equip_char and obj_to_char add to it,
+ * and this puts it right again when something comes off.
+ */
+void char_apply_update( CHAR_DATA *ch )
 {
-   /* Used to see if ch is HOLDING any object(s) with the specified
-    * ITEM_APPLY bit set.  
-    * -S-
-    */
-
    OBJ_DATA *obj;
 
+   ch->worn_apply = 0;
    for ( obj = ch->first_carry; obj != NULL; obj = obj->next_in_carry_list )
-      if ( IS_SET( obj->item_apply, bit ) && obj->wear_loc != WEAR_NONE ) 
-	 return TRUE;
-	    
-   return FALSE;
+      if ( obj->wear_loc != WEAR_NONE ) 
+	 SET_BIT( ch->worn_apply, obj->item_apply );
+   return;
+}
+
+/*
+ * Change an object's item_apply, keeping its wearer's worn_apply right.
+ */
+void set_item_apply( OBJ_DATA *obj, int bits, bool fSet )
+{
+   if ( fSet )
+      SET_BIT( obj->item_apply, bits );
+   else
+      REMOVE_BIT( obj->item_apply, bits );
+
+   if ( obj->carried_by != NULL && obj->wear_loc != WEAR_NONE )
+      char_apply_update( obj->carried_by );
+   return;
 }
 
 /* This is for immrotal authorized skills. Enables imms to set which skillks lower imms may use. handy for abuse control --Flar 
@@ -2609,6 +3054,7 @@ CHAR_DATA *switch_char( CHAR_DATA *victim, int mvnum, int poly_level )
    case 1:   /* Level 1 */
       mob->pcdata          = victim->pcdata;
       REMOVE_BIT( mob->act, ACT_IS_NPC);
+      room_kind_update( mob );
    
    case 0:   					/* Level 0 */
       mob->desc		= victim->desc;
@@ -2684,6 +3130,7 @@ CHAR_DATA *unswitch_char( CHAR_DATA * victim)
      
      case 0:
         SET_BIT( victim->act, ACT_IS_NPC );
+        room_kind_update( victim );
   } 
         
 
@@ -0,0 +1,328 @@
+/***************************************************************************
+ *  Original Diku Mud copyright (C) 1990, 1991 by Sebastian Hammer,        *
+ *  Michael Seifert, Hans Henrik St{rfeldt, Tom Madsen, and Katja Nyboe.   *
+ *                                                                         *
+ *  Merc Diku Mud improvments copyright (C) 1992, 1993 by Michael          *
+ *  Chastain, Michael Quan, and Mitchell Tse.                              *
+ *                                                                         *
+ *  Ack 2.2 improvements copyright (C) 1994 by Stephen Dooley              *
+ *                                                                         *
+ *  In order to use any part of this Merc Diku Mud, you must comply with   *
+ *  both the original Diku license in 'license.doc' as well the Merc       *
+ *  license in 'license.txt'.  In particular, you may not remove either of *
+ *  these copyright notices.                                               *
+ *                                                                         *
+ *       _/          _/_/_/     _/    _/     _/    ACK! MUD is modified    *
+ *      _/_/        _/          _/  _/       _/    Merc2.0/2.1/2.2 code    *
+ *     _/  _/      _/           _/_/         _/    (c)Stephen Zepp 1998    *
+ *    _/_/_/_/      _/          _/  _/             Version #: 4.3          *
+ *   _/      _/      _/_/_/     _/    _/     _/                            *
+ *                                                                         *
+ *                        http://ackmud.nuc.net/                           *
+ *                        zenithar@ackmud.nuc.net                          *
+ *  Much time and thought has gone into this software and you are          *
+ *  benefitting.  We hope that you share your changes too.  What goes      *
+ *  around, comes around.                                                  *
+ ***************************************************************************/
+
+/*
+ * helpidx.c: finding helps by keyword.
+ *
+ * do_help used to walk every help calling is_name(), which split every
+ * keyword list up again on every lookup.  Each keyword is now split once,
+ * when the help is loaded or added with addhelp, into a sorted array of
+ * (word, help) pairs.  Exact lookups are a binary search, and the words
+ * starting with some prefix sit together from where it would go.
+ *
+ * Helps for one word are kept in the order they were loaded, so the one
+ * found first is the one the old walk would have found.  Helps are never
+ * freed and their keywords never change, so nothing is ever taken out.
+ *
+ * When nothing starts with what was asked for, the text of every help
+ * is searched instead.  That only happens on a miss, and help text can
+ * be changed under us by the editor, so it isn't indexed.
+ */
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>
+#include "ack.h"
+
+
+struct help_key
+{
+    char *		word;		/* lowercased, as one_argument gives it */
+    HELP_DATA *		help;
+};
+
+static struct help_key *help_keys;
+static int help_nkeys;
+static int help_maxkeys;
+
+
+
+/*
+ * Where word goes in help_keys: before the first key not less than it,
+ * or if fAfter, after the last key equal to it.
+ */
+static int help_bound( const char *word, bool fAfter )
+{
+    int lo = 0;
+    int hi = help_nkeys;
+    int mid;
+    int cmp;
+
+    while ( lo < hi )
+    {
+	mid = ( lo + hi ) / 2;
+	cmp = strcmp( help_keys[mid].word, word );
+	if ( cmp < 0 || ( cmp == 0 && fAfter ) )
+	    lo = mid + 1;
+	else
+	    hi = mid;
+    }
+    return lo;
+}
+
+/*
+ * Lowercase argument into word, the way one_argument would have left a
+ * keyword.
+ */
+static void help_word( const char *argument, char *word )
+{
+    int i;
+
+    for ( i = 0; argument[i] != '\0' && i < MAX_INPUT_LENGTH - 1; i++ )
+	word[i] = LOWER( argument[i] );
+    word[i] = '\0';
+}
+
+
+
+/*
+ * Index the keywords of a help just linked onto the help list.
+ */
+void help_index_add( HELP_DATA *pHelp )
+{
+    char word[MAX_INPUT_LENGTH];
+    struct help_key *keys;
+    char *list;
+    int at;
+    int i;
+
+    for ( list = pHelp->keyword; ; )
+    {
+	list = one_argument( list, word );
+	if ( word[0] == '\0' )
+	    break;
+
+	at = help_bound( word, TRUE );
+	for ( i = at - 1; i >= 0 && !strcmp( help_keys[i].word, word ); i-- )
+	    if ( help_keys[i].help == pHelp )
+		break;
+	if ( i >= 0 && !strcmp( help_keys[i].word, word ) )
+	    continue;		/* same word twice in one keyword list */
+
+	if ( help_nkeys == help_maxkeys )
+	{
+	    help_maxkeys = UMAX( 256, help_maxkeys * 2 );
+	    keys = getmem( help_maxkeys * sizeof( *keys ) );
+	    if ( help_keys != NULL )
+	    {
+		memcpy( keys, help_keys, help_nkeys * sizeof( *keys ) );
+		dispose( help_keys, help_maxkeys / 2 * sizeof( *keys ) );
+	    }
+	    help_keys = keys;
+	}
+
+	memmove( &help_keys[at + 1], &help_keys[at],
+	    ( help_nkeys - at ) * sizeof( *help_keys ) );
+	help_keys[at].word = str_dup( word );
+	help_keys[at].help = pHelp;
+	help_nkeys++;
+    }
+    return;
+}
+
+/*
+ * The number'th help, counting from 1, with argument as one of its
+ * keywords and a level no higher than level.
+ */
+HELP_DATA *help_lookup( const char *argument, int level, int number )
+{
+    char word[MAX_INPUT_LENGTH];
+    int at;
+
+    help_word( argument, word );
+    for ( at = help_bound( word, FALSE );
+	  at < help_nkeys && !strcmp( help_keys[at].word, word ); at++ )
+    {
+	if ( help_keys[at].help->level > level )
+	    continue;
+	if ( --number <= 0 )
+	    return help_keys[at].help;
+    }
+    return NULL;
+}
+
+
+
+/*
+ * How often word (of len letters, lowercased) starts a word in text.
+ */
+static int help_count_word( const char *text, const char *word, int len )
+{
+    const char *p;
+    int count = 0;
+    int i;
+
+    for ( p = text; *p != '\0'; p++ )
+    {
+	if ( p > text && isalnum( (unsigned char) p[-1] ) )
+	    continue;
+	for ( i = 0; i < len && LOWER( p[i] ) == word[i]; i++ )
+	    ;
+	if ( i == len )
+	    count++;
+    }
+    return count;
+}
+
+/*
+ * Keep the HELP_SHOW best scoring helps in found[], best first.  Ties
+ * go to whichever came first.
+ */
+static int help_rank( HELP_DATA **found, int *score, int n,
+		      HELP_DATA *pHelp, int points )
+{
+    int i;
+
+    if ( n == HELP_SHOW && points <= score[n - 1] )
+	return n;
+    if ( n < HELP_SHOW )
+	n++;
+    for ( i = n - 1; i > 0 && score[i - 1] < points; i-- )
+    {
+	found[i] = found[i - 1];
+	score[i] = score[i - 1];
+    }
+    found[i] = pHelp;
+    score[i] = points;
+    return n;
+}
+
+static void help_list( CHAR_DATA *ch, HELP_DATA **found, int n )
+{
+    char buf[MAX_STRING_LENGTH];
+    int i;
+
+    for ( i = 0; i < n; i++ )
+    {
+	sprintf( buf, "  %-.70s\n\r", found[i]->keyword );
+	send_to_char( buf, ch );
+    }
+    return;
+}
+
+/*
+ * Nothing has argument as a keyword.  If just one help has a keyword
+ * starting with it, that's the one.  Otherwise list the helps with such
+ * keywords, shortest keyword first, or failing that the helps whose text
+ * has every word of argument in it, those with the most first.
+ */
+HELP_DATA *help_search( CHAR_DATA *ch, char *argument )
+{
+    static int stamp;
+    HELP_DATA *found[HELP_SHOW];
+    int score[HELP_SHOW];
+    char word[MAX_INPUT_LENGTH];
+    char buf[MAX_STRING_LENGTH];
+    char *words[HELP_WORDS];
+    char *p;
+    HELP_DATA *pHelp;
+    int level = get_trust( ch );
+    int len;
+    int nwords;
+    int points;
+    int total = 0;
+    int n = 0;
+    int at;
+    int i;
+
+    /* A help is counted once, however many of its keywords match. */
+    stamp++;
+    help_word( argument, word );
+    len = strlen( word );
+    for ( at = help_bound( word, FALSE );
+	  at < help_nkeys && !strncmp( help_keys[at].word, word, len ); at++ )
+    {
+	pHelp = help_keys[at].help;
+	if ( pHelp->level > level || pHelp->search == stamp )
+	    continue;
+	pHelp->search = stamp;
+	/* the closest fit first, and the old order past that */
+	total++;
+	n = help_rank( found, score, n, pHelp,
+	    -(int) strlen( help_keys[at].word ) );
+    }
+
+    if ( total == 1 )
+	return found[0];
+    if ( total > 1 )
+    {
+	sprintf( buf, "%d helps have a keyword starting with '%s':\n\r",
+	    total, word );
+	send_to_char( buf, ch );
+	help_list( ch, found, n );
+	return NULL;
+    }
+
+    /* Full text, then. */
+    nwords = 0;
+    for ( p = strtok( word, " '\"" ); p != NULL && nwords < HELP_WORDS;
+	  p = strtok( NULL, " '\"" ) )
+	words[nwords++] = p;
+
+    for ( pHelp = first_help; nwords > 0 && pHelp != NULL; pHelp = pHelp->next )
+    {
+	if ( pHelp->level > level )
+	    continue;
+	points = 0;
+	for ( i = 0; i < nwords; i++ )
+	{
+	    at = help_count_word( pHelp->text, words[i], strlen( words[i] ) );
+	    if ( at == 0 )
+		break;
+	    points += at;
+	}
+	if ( i < nwords )
+	    continue;
+	total++;
+	n = help_rank( found, score, n, pHelp, points );
+    }
+
+    if ( total == 0 )
+    {
+	send_to_char( "No help on that word.\n\r", ch );
+	return NULL;
+    }
+    sprintf( buf, "No help on that word, but %d help%s mention%s it:\n\r",
+	total, total == 1 ? "" : "s", total == 1 ? "s" : "" );
+    send_to_char( buf, ch );
+    help_list( ch, found, n );
+    return NULL;
+}
+
+
+
+void help_markstrings( void (*touch)( char *str ) )
+{
+    int i;
+
+    for ( i = 0; i < help_nkeys; i++ )
+	touch( help_keys[i].word );
+    return;
+}
@@ -40,93 +40,347 @@
 #include <ctype.h>
 #include "ack.h"
 
-#define NEVER_FREE_HUNT
+/*
+ * Pathfinding.  A room gets a small integer id (hunt_id) the first time
+ * a search touches it, and the id indexes flat arrays.  h_seen[] holds
+ * the number of the search that last reached the room, so a new search
+ * just bumps h_search and nothing needs unmarking afterwards; h_first[]
+ * is the direction out of the start room that led there.  The queue is
+ * a ring of room pointers, big enough that it never has to grow while a
+ * search is running, and a search stops as soon as it reaches its target.
+ *
+ * A search can also go from both ends at once, a level at a time from
+ * whichever side has fewer rooms waiting, until the two meet.  Going
+ * backwards needs to know which rooms lead into a room; that comes from
+ * h_in[], built from every room's exits and rebuilt after building
+ * changes them (hunt_graph_changed).  'huntstat bidir' turns it on for
+ * HUNT_WORLD searches, and 'huntstat bench' times the two against each
+ * other.
+ *
+ * Most of the time, though, h_find_dir answers from a next-hop tree.
+ * Hunters mostly chase a target that stays put for a while, and often
+ * several chase the same one, so rather than search from each hunter
+ * every step, a tree is grown backwards from the target room: for each
+ * room it reaches it keeps the way out that is one step nearer.  It only
+ * grows as far as the room asked about, and carries on from there next
+ * time.  HUNT_TREE_CACHE of them are kept, for the targets asked about
+ * most recently; one is thrown away when the exits change, or when a door
+ * opens or shuts and the tree's hunters can't get through every door.
+ * A target that moves just gets a new tree.
+ *
+ * Before any of that, the area map is asked whether the target's area
+ * can be reached from the hunter's at all.  It knows, for every pair of
+ * areas, how many area borders lie between them along exits that cross
+ * from one area into another, doors or no doors.  A hunt it says is
+ * hopeless gives up straight away instead of flooding every room it can
+ * get to first, and a world search never steps into an area the target
+ * can't be reached from.  Building changes throw it out along with
+ * h_in[], and the next hunt builds it again.
+ */
+extern char * const dir_name[];
+extern int top_room;
+
+static int		h_top_id;	/* ids handed out so far   */
+static int		h_max_id;	/* size of the arrays      */
+static int *		h_seen;
+static int *		h_dist;
+static sh_int *		h_first;
+static int *		h_seen_back;
+static int *		h_dist_back;
+static ROOM_INDEX_DATA ** h_ring;
+static ROOM_INDEX_DATA ** h_ring_back;
+static int		h_mask;		/* ring size - 1           */
+static int		h_search;
+
+/* rooms leading into id are h_in[h_in_start[id]] to h_in[h_in_start[id+1]] */
+static ROOM_INDEX_DATA ** h_in;
+static int *		h_in_start;
+static int		h_in_ids;	/* ids the graph covers    */
+static int		h_in_size;
+static bool		h_in_stale = TRUE;
+
+bool			hunt_bidir = FALSE;
+static int		h_last_dist;	/* steps to the last target found */
 
-struct h_queue
+struct h_tree
 {
-  struct h_queue *next;
-  ROOM_INDEX_DATA *room;
-  sh_int dir;
+    ROOM_INDEX_DATA *	target;		/* NULL if not in use      */
+    int			flags;
+    int			size;		/* ids the arrays cover    */
+    int *		dist;		/* -1 until reached        */
+    sh_int *		step;		/* way out towards target  */
+    ROOM_INDEX_DATA **	queue;
+    int			head;
+    int			tail;
+    long		used;
 };
 
-struct h_queue *h_head = NULL;
-struct h_queue *h_tail = NULL;
-extern char * const dir_name[];
+/* the hunt flags that change which exits can be used */
+#define H_PATH_FLAGS	( HUNT_WORLD|HUNT_OPENDOOR|HUNT_UNLOCKDOOR|HUNT_PICKDOOR )
 
-#ifdef NEVER_FREE_HUNT
-struct h_queue *h_free= NULL;
-void setup_hunt(void);
-#endif
+static struct h_tree	h_trees[HUNT_TREE_CACHE];
+static long		h_tree_clock;
+static long		h_tree_built;
+static long		h_tree_dropped;
+bool			hunt_trees = TRUE;
 
-#ifdef DEBUG_HUNT_CODE
-static FILE *h_fp;
-#endif
+/* areas a and b are h_area_dist[a * h_areas + b] borders apart, or -1 */
+static sh_int *		h_area_dist;
+static int		h_areas;	/* areas numbered, plus one */
+static int		h_area_links;
+static bool		h_area_stale = TRUE;
+static long		h_area_cuts;
+bool			hunt_areas = TRUE;
+
+static long		h_searches[3];
+static long		h_visits[3];
+static long long	h_usec[3];
+
+#define H_GROW( array, old, new )					\
+do {									\
+    void *h_new = getmem( (new) * sizeof( *(array) ) );		\
+    if ( (array) != NULL )						\
+    {									\
+	memcpy( h_new, (array), (old) * sizeof( *(array) ) );		\
+	dispose( (array), (old) * sizeof( *(array) ) );			\
+    }									\
+    (array) = h_new;							\
+} while ( 0 )
 
-void h_enqueue( ROOM_INDEX_DATA *room, sh_int dir )
+/*
+ * Make sure the arrays can take every room in the world getting an id
+ * during the coming search, and start it.
+ */
+static void h_begin( void )
 {
-  struct h_queue *hunt;
-  
-#ifdef NEVER_FREE_HUNT
-  if ( h_free )
-  {
-    hunt = h_free;
-    h_free = h_free->next;
-  }
-  else
-#endif
-    hunt = getmem(sizeof(*hunt));
-  hunt->next = NULL;
-  hunt->room = room;
-  hunt->dir = dir;
-  SET_BIT(room->room_flags, ROOM_HUNT_MARK);
-  if ( !h_head )
-    h_head = hunt;
-  else
-    h_tail->next = hunt;
-  h_tail = hunt;
-#ifdef DEBUG_HUNT_CODE
-  fprintf(h_fp, "Enqueue: %5d - %d\n", room->vnum,
-          IS_SET(room->room_flags, ROOM_HUNT_MARK));
-  fflush(h_fp);
-#endif
-  return;
+    int size;
+
+    if ( h_top_id + top_room + 1 >= h_max_id )
+    {
+	for ( size = UMAX( h_max_id, 1024 ); size <= h_top_id + top_room + 1; )
+	    size *= 2;
+	H_GROW( h_seen,      h_max_id, size );
+	H_GROW( h_dist,      h_max_id, size );
+	H_GROW( h_first,     h_max_id, size );
+	H_GROW( h_seen_back, h_max_id, size );
+	H_GROW( h_dist_back, h_max_id, size );
+	if ( h_ring != NULL )
+	{
+	    dispose( h_ring, h_max_id * sizeof( *h_ring ) );
+	    dispose( h_ring_back, h_max_id * sizeof( *h_ring_back ) );
+	}
+	h_ring      = getmem( size * sizeof( *h_ring ) );
+	h_ring_back = getmem( size * sizeof( *h_ring_back ) );
+	h_max_id = size;
+	h_mask   = size - 1;
+    }
+
+    if ( ++h_search <= 0 )
+    {
+	memset( h_seen, 0, h_max_id * sizeof( *h_seen ) );
+	memset( h_seen_back, 0, h_max_id * sizeof( *h_seen_back ) );
+	h_search = 1;
+    }
+    return;
 }
 
-void h_dequeue( void )
+static int h_id( ROOM_INDEX_DATA *room )
 {
-  struct h_queue *hunt;
-  
-  if ( !(hunt = h_head) )
+    if ( room->hunt_id == 0 )
+	room->hunt_id = ++h_top_id;
+    return room->hunt_id;
+}
+
+/*
+ * Building has changed some exits, so the backwards graph is out.
+ */
+void hunt_graph_changed( void )
+{
+    h_in_stale = TRUE;
+    h_area_stale = TRUE;
     return;
-  h_head = hunt->next;
-  if ( h_tail == hunt )
-    h_tail = NULL;
-  REMOVE_BIT(hunt->room->room_flags, ROOM_HUNT_MARK);
-#ifdef DEBUG_HUNT_CODE
-  fprintf(h_fp, "Dequeue: %5d\n", hunt->room->vnum);
-  fflush(h_fp);
-#endif
-#ifdef NEVER_FREE_HUNT
-  hunt->next = h_free;
-  h_free = hunt;
-#else
-  dispose(hunt, sizeof(*hunt));
-#endif
-  return;
 }
 
-void h_clear( void )
+/*
+ * A door has opened, shut, locked or unlocked.  Trees for hunters who
+ * can open and unlock anything don't care.
+ */
+void hunt_doors_changed( void )
 {
-#ifdef DEBUG_HUNT_CODE
-  fprintf(h_fp, "h_clear\n");
-  fflush(h_fp);
-#endif
-  while ( h_head != NULL )
-    h_dequeue();
-#ifdef DEBUG_HUNT_CODE
-  fprintf(h_fp, "Cleared\n");
-  fflush(h_fp);
-#endif
+    int i;
+
+    for ( i = 0; i < HUNT_TREE_CACHE; i++ )
+	if ( h_trees[i].target != NULL
+	&&   ( h_trees[i].flags & ( HUNT_OPENDOOR|HUNT_UNLOCKDOOR ) )
+	     != ( HUNT_OPENDOOR|HUNT_UNLOCKDOOR ) )
+	{
+	    h_trees[i].target = NULL;
+	    h_tree_dropped++;
+	}
+    return;
+}
+
+static void h_graph_build( void )
+{
+    ROOM_INDEX_DATA *room;
+    ROOM_INDEX_DATA *to;
+    int *fill;
+    int iHash;
+    int door;
+    int edges = 0;
+    int id;
+
+    for ( iHash = 0; iHash < MAX_KEY_HASH; iHash++ )
+	for ( room = room_index_hash[iHash]; room != NULL; room = room->next )
+	{
+	    h_id( room );
+	    for ( door = 0; door < 6; door++ )
+		if ( room->exit[door] != NULL && room->exit[door]->to_room != NULL )
+		    edges++;
+	}
+
+    if ( h_in_start != NULL )
+    {
+	dispose( h_in_start, ( h_in_ids + 2 ) * sizeof( *h_in_start ) );
+	dispose( h_in, UMAX( h_in_size, 1 ) * sizeof( *h_in ) );
+    }
+    h_in_ids   = h_top_id;
+    h_in_size  = edges;
+    h_in_start = getmem( ( h_in_ids + 2 ) * sizeof( *h_in_start ) );
+    h_in       = getmem( UMAX( h_in_size, 1 ) * sizeof( *h_in ) );
+    fill       = getmem( ( h_in_ids + 2 ) * sizeof( *fill ) );
+
+    /* count what leads into each room, then drop them in place */
+    for ( iHash = 0; iHash < MAX_KEY_HASH; iHash++ )
+	for ( room = room_index_hash[iHash]; room != NULL; room = room->next )
+	    for ( door = 0; door < 6; door++ )
+		if ( room->exit[door] != NULL
+		&& ( to = room->exit[door]->to_room ) != NULL )
+		    h_in_start[h_id( to ) + 1]++;
+    for ( id = 1; id <= h_in_ids + 1; id++ )
+    {
+	h_in_start[id] += h_in_start[id - 1];
+	fill[id] = h_in_start[id];
+    }
+    for ( iHash = 0; iHash < MAX_KEY_HASH; iHash++ )
+	for ( room = room_index_hash[iHash]; room != NULL; room = room->next )
+	    for ( door = 0; door < 6; door++ )
+		if ( room->exit[door] != NULL
+		&& ( to = room->exit[door]->to_room ) != NULL )
+		    h_in[fill[to->hunt_id]++] = room;
+
+    dispose( fill, ( h_in_ids + 2 ) * sizeof( *fill ) );
+    h_in_stale = FALSE;
+
+    /* the trees were grown over the old graph */
+    for ( id = 0; id < HUNT_TREE_CACHE; id++ )
+	if ( h_trees[id].target != NULL )
+	{
+	    h_trees[id].target = NULL;
+	    h_tree_dropped++;
+	}
+    return;
+}
+
+/*
+ * Number the areas, link any two an exit crosses between, and find how
+ * far apart every pair is.
+ */
+static void h_area_build( void )
+{
+    AREA_DATA *pArea;
+    ROOM_INDEX_DATA *room;
+    ROOM_INDEX_DATA *to;
+    bool *link;
+    int *queue;
+    int iHash;
+    int door;
+    int from;
+    int head;
+    int tail;
+    int a;
+    int b;
+
+    if ( h_area_dist != NULL )
+	dispose( h_area_dist, h_areas * h_areas * sizeof( *h_area_dist ) );
+    h_areas = 1;
+    for ( pArea = first_area; pArea != NULL; pArea = pArea->next )
+	pArea->hunt_id = h_areas++;
+
+    link = getmem( h_areas * h_areas * sizeof( *link ) );
+    h_area_links = 0;
+    for ( iHash = 0; iHash < MAX_KEY_HASH; iHash++ )
+	for ( room = room_index_hash[iHash]; room != NULL; room = room->next )
+	    for ( door = 0; door < 6; door++ )
+		if ( room->exit[door] != NULL
+		&& ( to = room->exit[door]->to_room ) != NULL
+		&&   to->area != room->area
+		&&   room->area != NULL && to->area != NULL
+		&&  !link[room->area->hunt_id * h_areas + to->area->hunt_id] )
+		{
+		    link[room->area->hunt_id * h_areas + to->area->hunt_id] = TRUE;
+		    h_area_links++;
+		}
+
+    h_area_dist = getmem( h_areas * h_areas * sizeof( *h_area_dist ) );
+    memset( h_area_dist, 0xff, h_areas * h_areas * sizeof( *h_area_dist ) );
+    queue = getmem( h_areas * sizeof( *queue ) );
+    for ( from = 1; from < h_areas; from++ )
+    {
+	h_area_dist[from * h_areas + from] = 0;
+	head = tail = 0;
+	queue[tail++] = from;
+	while ( head != tail )
+	{
+	    a = queue[head++];
+	    for ( b = 1; b < h_areas; b++ )
+		if ( link[a * h_areas + b] && h_area_dist[from * h_areas + b] < 0 )
+		{
+		    h_area_dist[from * h_areas + b] =
+			h_area_dist[from * h_areas + a] + 1;
+		    queue[tail++] = b;
+		}
+	}
+    }
+    dispose( queue, h_areas * sizeof( *queue ) );
+    dispose( link, h_areas * h_areas * sizeof( *link ) );
+    h_area_stale = FALSE;
+    return;
+}
+
+/*
+ * Can anything in area to be got to from area from?  Areas the map
+ * doesn't know about yet might be.
+ */
+static bool h_area_reach( AREA_DATA *from, AREA_DATA *to )
+{
+    if ( from == to || from == NULL || to == NULL )
+	return TRUE;
+    if ( from->hunt_id <= 0 || from->hunt_id >= h_areas
+    ||   to->hunt_id <= 0 || to->hunt_id >= h_areas )
+	return TRUE;
+    return h_area_dist[from->hunt_id * h_areas + to->hunt_id] >= 0;
+}
+
+/*
+ * TRUE if the area map says there's no getting from room to target.
+ */
+static bool h_area_cut( ROOM_INDEX_DATA *room, ROOM_INDEX_DATA *target,
+			int h_flags )
+{
+    if ( !hunt_areas )
+	return FALSE;
+    if ( h_area_stale
+    || ( room->area != NULL && room->area->hunt_id == 0 )
+    || ( target->area != NULL && target->area->hunt_id == 0 ) )
+	h_area_build( );
+    if ( room->area == target->area )
+	return FALSE;
+    if ( IS_SET( h_flags, HUNT_WORLD )
+    &&   h_area_reach( room->area, target->area ) )
+	return FALSE;
+    h_area_cuts++;
+    return TRUE;
 }
 
 bool h_is_valid_exit( ROOM_INDEX_DATA *room, sh_int dir, int h_flags )
@@ -137,14 +391,6 @@ bool h_is_valid_exit( ROOM_INDEX_DATA *room, sh_int dir, int h_flags )
     return FALSE;
   if ( !exit->to_room )
     return FALSE;
-#ifdef DEBUG_HUNT_CODE
-  fprintf(h_fp, "IsValid: %5d - %s\n", exit->to_room->vnum,
-         (IS_SET(exit->to_room->room_flags, ROOM_HUNT_MARK) ? "set"
-         						    : "unset"));
-  fflush(h_fp);
-#endif
-  if ( IS_SET(exit->to_room->room_flags, ROOM_HUNT_MARK) )
-    return FALSE;
   if ( !IS_SET(h_flags, HUNT_WORLD) && room->area != exit->to_room->area )
     return FALSE;
   if ( IS_SET(exit->exit_info, EX_CLOSED) )
@@ -163,62 +409,303 @@ bool h_is_valid_exit( ROOM_INDEX_DATA *room, sh_int dir, int h_flags )
   return TRUE;
 }
 
-void h_enqueue_room( ROOM_INDEX_DATA *room, sh_int dir, int h_flags )
+/*
+ * Breadth first from room, returning the first step towards target.
+ */
+static sh_int h_search_from( ROOM_INDEX_DATA *room, ROOM_INDEX_DATA *target,
+			     int h_flags )
 {
-  sh_int edir;
+  ROOM_INDEX_DATA *here;
+  ROOM_INDEX_DATA *to;
+  int head = 0;
+  int tail = 0;
+  int id;
+  bool prune;
+  sh_int dir;
   
-#ifdef DEBUG_HUNT_CODE
-  fprintf(h_fp, "h_enqueue_room\n");
-  fflush(h_fp);
-#endif
-  for ( edir = 0; edir < 6; edir++ )
-    if ( h_is_valid_exit(room, edir, h_flags) )
-      h_enqueue(room->exit[edir]->to_room, (dir == -1 ? edir : dir));
+  if ( h_area_cut(room, target, h_flags) )
+    return -1;
+  prune = (hunt_areas && IS_SET(h_flags, HUNT_WORLD));
+  h_begin();
+  id = h_id(room);
+  h_seen[id] = h_search;
+  h_dist[id] = 0;
+  h_first[id] = -1;
+  h_ring[tail++ & h_mask] = room;
+
+  while ( head != tail )
+  {
+    here = h_ring[head++ & h_mask];
+    h_visits[0]++;
+    for ( dir = 0; dir < 6; dir++ )
+    {
+      if ( !h_is_valid_exit(here, dir, h_flags) )
+        continue;
+      to = here->exit[dir]->to_room;
+      id = h_id(to);
+      if ( h_seen[id] == h_search )
+        continue;
+      h_seen[id] = h_search;
+      h_dist[id] = h_dist[here->hunt_id] + 1;
+      h_first[id] = (here == room ? dir : h_first[here->hunt_id]);
+      if ( to == target )
+      {
+        h_last_dist = h_dist[id];
+        return h_first[id];
+      }
+      if ( prune && !h_area_reach(to->area, target->area) )
+        continue;
+      h_ring[tail++ & h_mask] = to;
+    }
+  }
+  return -1;
+}
+
+/*
+ * The same, from both ends.  Each pass takes a whole level off the
+ * smaller side, and any meeting found in it is as short as they come.
+ */
+static sh_int h_search_both( ROOM_INDEX_DATA *room, ROOM_INDEX_DATA *target,
+			     int h_flags )
+{
+  ROOM_INDEX_DATA *here;
+  ROOM_INDEX_DATA *to;
+  int head = 0, tail = 0;
+  int bhead = 0, btail = 0;
+  int best = -1;
+  int level;
+  int id;
+  int i;
+  sh_int best_dir = -1;
+  sh_int dir;
+  bool prune;
+
+  if ( h_area_cut(room, target, h_flags) )
+    return -1;
+  prune = (hunt_areas && IS_SET(h_flags, HUNT_WORLD));
+  if ( h_in_stale || h_top_id > h_in_ids )
+    h_graph_build();
+  h_begin();
+  id = h_id(room);
+  h_seen[id] = h_search;
+  h_dist[id] = 0;
+  h_first[id] = -1;
+  h_ring[tail++ & h_mask] = room;
+  id = h_id(target);
+  h_seen_back[id] = h_search;
+  h_dist_back[id] = 0;
+  h_ring_back[btail++ & h_mask] = target;
+
+  while ( best < 0 && head != tail && bhead != btail )
+  {
+    if ( tail - head <= btail - bhead )
+    {
+      for ( level = tail; head != level; )
+      {
+        here = h_ring[head++ & h_mask];
+        h_visits[1]++;
+        for ( dir = 0; dir < 6; dir++ )
+        {
+          if ( !h_is_valid_exit(here, dir, h_flags) )
+            continue;
+          to = here->exit[dir]->to_room;
+          id = h_id(to);
+          if ( h_seen_back[id] == h_search
+          && ( best < 0
+            || h_dist[here->hunt_id] + 1 + h_dist_back[id] < best ) )
+          {
+            best = h_dist[here->hunt_id] + 1 + h_dist_back[id];
+            best_dir = (here == room ? dir : h_first[here->hunt_id]);
+          }
+          if ( h_seen[id] == h_search )
+            continue;
+          h_seen[id] = h_search;
+          h_dist[id] = h_dist[here->hunt_id] + 1;
+          h_first[id] = (here == room ? dir : h_first[here->hunt_id]);
+          if ( prune && !h_area_reach(to->area, target->area) )
+            continue;
+          h_ring[tail++ & h_mask] = to;
+        }
+      }
+    }
+    else
+    {
+      for ( level = btail; bhead != level; )
+      {
+        to = h_ring_back[bhead++ & h_mask];
+        h_visits[1]++;
+        if ( to->hunt_id > h_in_ids )
+          continue;		/* nothing led here when the graph was built */
+        for ( i = h_in_start[to->hunt_id]; i < h_in_start[to->hunt_id + 1]; i++ )
+        {
+          here = h_in[i];
+          id = h_id(here);
+          for ( dir = 0; dir < 6; dir++ )
+          {
+            if ( here->exit[dir] == NULL || here->exit[dir]->to_room != to
+            ||  !h_is_valid_exit(here, dir, h_flags) )
+              continue;
+            if ( h_seen[id] == h_search
+            && ( best < 0 || h_dist[id] + 1 + h_dist_back[to->hunt_id] < best ) )
+            {
+              best = h_dist[id] + 1 + h_dist_back[to->hunt_id];
+              best_dir = (here == room ? dir : h_first[id]);
+            }
+            if ( h_seen_back[id] == h_search )
+              continue;
+            h_seen_back[id] = h_search;
+            h_dist_back[id] = h_dist_back[to->hunt_id] + 1;
+            if ( prune && !h_area_reach(room->area, here->area) )
+              continue;
+            h_ring_back[btail++ & h_mask] = here;
+          }
+        }
+      }
+    }
+  }
+  h_last_dist = best;
+  return best_dir;
+}
+
+/*
+ * Start a tree growing back from target.
+ */
+static void h_tree_start( struct h_tree *tree, ROOM_INDEX_DATA *target,
+			  int h_flags )
+{
+  if ( tree->size != h_in_ids + 1 )
+  {
+    if ( tree->size > 0 )
+    {
+      dispose(tree->dist, tree->size * sizeof(*tree->dist));
+      dispose(tree->step, tree->size * sizeof(*tree->step));
+      dispose(tree->queue, tree->size * sizeof(*tree->queue));
+    }
+    tree->size  = h_in_ids + 1;
+    tree->dist  = getmem(tree->size * sizeof(*tree->dist));
+    tree->step  = getmem(tree->size * sizeof(*tree->step));
+    tree->queue = getmem(tree->size * sizeof(*tree->queue));
+  }
+  memset(tree->dist, 0xff, tree->size * sizeof(*tree->dist));
+  tree->target = target;
+  tree->flags = h_flags;
+  tree->head = 0;
+  tree->tail = 0;
+  tree->dist[target->hunt_id] = 0;
+  tree->step[target->hunt_id] = -1;
+  tree->queue[tree->tail++] = target;
+  h_tree_built++;
   return;
 }
 
-sh_int h_find_dir( ROOM_INDEX_DATA *room, ROOM_INDEX_DATA *target,
-                   int h_flags )
+/*
+ * Grow a tree until it reaches room, or there's nowhere left to go.
+ */
+static bool h_tree_grow( struct h_tree *tree, ROOM_INDEX_DATA *room )
 {
-  struct h_queue *hunt;
-  
-  if ( room == target )
+  ROOM_INDEX_DATA *here;
+  ROOM_INDEX_DATA *to;
+  sh_int dir;
+  int i;
+
+  while ( tree->dist[room->hunt_id] < 0 && tree->head != tree->tail )
+  {
+    to = tree->queue[tree->head++];
+    h_visits[2]++;
+    for ( i = h_in_start[to->hunt_id]; i < h_in_start[to->hunt_id + 1]; i++ )
+    {
+      here = h_in[i];
+      if ( tree->dist[here->hunt_id] >= 0 )
+        continue;
+      for ( dir = 0; dir < 6; dir++ )
+        if ( here->exit[dir] != NULL && here->exit[dir]->to_room == to
+        &&   h_is_valid_exit(here, dir, tree->flags) )
+        {
+          tree->dist[here->hunt_id] = tree->dist[to->hunt_id] + 1;
+          tree->step[here->hunt_id] = dir;
+          tree->queue[tree->tail++] = here;
+          break;
+        }
+    }
+  }
+  return tree->dist[room->hunt_id] >= 0;
+}
+
+/*
+ * The first step from room to target, out of the tree for target.
+ */
+static sh_int h_tree_dir( ROOM_INDEX_DATA *room, ROOM_INDEX_DATA *target,
+			  int h_flags )
+{
+  struct h_tree *tree = NULL;
+  struct h_tree *oldest = &h_trees[0];
+  sh_int dir;
+  int i;
+
+  h_flags &= H_PATH_FLAGS;
+  if ( h_area_cut(room, target, h_flags) )
     return -1;
-#ifdef DEBUG_HUNT_CODE
-  if ( !h_fp )
-    h_fp = fopen("hunt.out", "w");
-  fprintf(h_fp, "h_find_dir\n");
-  fflush(h_fp);
-#endif
-#ifdef NEVER_FREE_HUNT
-  if ( !h_free && !h_head && !h_tail )
-    setup_hunt();
-#endif
-  SET_BIT(room->room_flags, ROOM_HUNT_MARK);
-  h_enqueue_room(room, -1, h_flags);
-  for ( hunt = h_head; hunt; hunt = hunt->next )
+  h_id(room);
+  h_id(target);
+  if ( h_in_stale || h_top_id > h_in_ids )
+    h_graph_build();
+
+  for ( i = 0; i < HUNT_TREE_CACHE; i++ )
   {
-    if ( hunt->room == target )
+    if ( h_trees[i].target == target && h_trees[i].flags == h_flags )
     {
-      sh_int dir = hunt->dir;
-      
-#ifdef DEBUG_HUNT_CODE
-      fprintf(h_fp, "Found dir %d\n", dir);
-      fflush(h_fp);
-#endif
-      h_clear();
-      REMOVE_BIT(room->room_flags, ROOM_HUNT_MARK);
-      return dir;
+      tree = &h_trees[i];
+      break;
     }
-    h_enqueue_room(hunt->room, hunt->dir, h_flags);
+    if ( h_trees[i].target == NULL
+    || ( oldest->target != NULL && h_trees[i].used < oldest->used ) )
+      oldest = &h_trees[i];
   }
-#ifdef DEBUG_HUNT_CODE
-  fprintf(h_fp,"Invalid dir\n");
-  fflush(h_fp);
-#endif
-  h_clear();
-  REMOVE_BIT(room->room_flags, ROOM_HUNT_MARK);
-  return -1;
+  if ( tree == NULL )
+  {
+    tree = oldest;
+    h_tree_start(tree, target, h_flags);
+  }
+  tree->used = ++h_tree_clock;
+
+  if ( !h_tree_grow(tree, room) )
+    return -1;
+  dir = tree->step[room->hunt_id];
+  if ( !h_is_valid_exit(room, dir, h_flags) )
+  {
+    /* a door changed that nobody told us about */
+    h_tree_start(tree, target, h_flags);
+    if ( !h_tree_grow(tree, room) )
+      return -1;
+    dir = tree->step[room->hunt_id];
+  }
+  h_last_dist = tree->dist[room->hunt_id];
+  return dir;
+}
+
+sh_int h_find_dir( ROOM_INDEX_DATA *room, ROOM_INDEX_DATA *target,
+                   int h_flags )
+{
+  long long start;
+  sh_int dir;
+  int which;
+  
+  if ( room == target )
+    return -1;
+  if ( hunt_trees )
+    which = 2;
+  else
+    which = (hunt_bidir && IS_SET(h_flags, HUNT_WORLD) ? 1 : 0);
+  start = current_usec();
+  if ( which == 0 )
+    dir = h_search_from(room, target, h_flags);
+  else if ( which == 1 )
+    dir = h_search_both(room, target, h_flags);
+  else
+    dir = h_tree_dir(room, target, h_flags);
+  h_usec[which] += current_usec() - start;
+  h_searches[which]++;
+  return dir;
 }
 
 bool set_hunt( CHAR_DATA *ch, CHAR_DATA *fch, CHAR_DATA *vch, OBJ_DATA *vobj,
@@ -683,20 +1170,258 @@ void do_hunt( CHAR_DATA *ch, char *argument )
   return;
 }
 
-#ifdef NEVER_FREE_HUNT
-#define MAX_BUCKET_SIZE	4096
-#define TOP_BUCKET_LIST	4095
-void setup_hunt( void )
+/*
+ * 'huntstat chase [n]': n hunters start in random rooms after a handful
+ * of targets, which wander off every so often, and walk the trees to
+ * them.  Every step is also searched for afresh, to time it and check
+ * the tree gives a path as short.
+ */
+#define H_CHASE_TARGETS	4
+#define H_CHASE_STEPS	200
+static void h_chase( CHAR_DATA *ch, ROOM_INDEX_DATA **rooms, int nrooms,
+		     int n )
+{
+  static char * const kind[2] = { "searching", "trees" };
+  char buf[MAX_STRING_LENGTH];
+  ROOM_INDEX_DATA *target[H_CHASE_TARGETS];
+  ROOM_INDEX_DATA **hunter;
+  long long took[2];
+  long long start;
+  long visits[3];
+  long built = h_tree_built;
+  long steps = 0;
+  int flags = H_PATH_FLAGS;
+  int dist[2];
+  int step;
+  int wrong = 0;
+  int caught = 0;
+  int i;
+  sh_int dir[2];
+
+  hunter = getmem(n * sizeof(*hunter));
+  for ( i = 0; i < H_CHASE_TARGETS; i++ )
+    target[i] = rooms[number_range(0, nrooms - 1)];
+  for ( i = 0; i < n; i++ )
+    hunter[i] = rooms[number_range(0, nrooms - 1)];
+  for ( i = 0; i < 3; i++ )
+    visits[i] = h_visits[i];
+  took[0] = took[1] = 0;
+
+  for ( step = 0; step < H_CHASE_STEPS; step++ )
+  {
+    if ( step > 0 && step % 20 == 0 )
+      for ( i = 0; i < H_CHASE_TARGETS; i++ )
+      {
+        sh_int door = number_door();
+
+        if ( h_is_valid_exit(target[i], door, flags) )
+          target[i] = target[i]->exit[door]->to_room;
+      }
+
+    for ( i = 0; i < n; i++ )
+    {
+      ROOM_INDEX_DATA *goal = target[i % H_CHASE_TARGETS];
+
+      if ( hunter[i] == NULL )
+        continue;
+      if ( hunter[i] == goal )
+      {
+        caught++;
+        hunter[i] = NULL;
+        continue;
+      }
+      start = current_usec();
+      dir[0] = h_search_from(hunter[i], goal, flags);
+      dist[0] = h_last_dist;
+      took[0] += current_usec() - start;
+
+      start = current_usec();
+      dir[1] = h_tree_dir(hunter[i], goal, flags);
+      dist[1] = h_last_dist;
+      took[1] += current_usec() - start;
+
+      steps++;
+      if ( ( dir[0] < 0 ) != ( dir[1] < 0 )
+      || ( dir[0] >= 0 && dist[0] != dist[1] ) )
+      {
+        wrong++;
+        bugf("huntstat: %d to %d is %d steps searching, %d by the tree.",
+             hunter[i]->vnum, goal->vnum,
+             (dir[0] < 0 ? -1 : dist[0]), (dir[1] < 0 ? -1 : dist[1]));
+      }
+      hunter[i] = (dir[1] < 0 ? NULL : hunter[i]->exit[dir[1]]->to_room);
+    }
+  }
+  dispose(hunter, n * sizeof(*hunter));
+
+  sprintf(buf, "%d hunters after %d targets, %ld steps, %d caught:\n\r",
+          n, H_CHASE_TARGETS, steps, caught);
+  send_to_char(buf, ch);
+  for ( i = 0; i < 2; i++ )
+  {
+    sprintf(buf, "%-9s %8lld usec in all, %ld rooms looked at\n\r",
+            kind[i], took[i], h_visits[i * 2] - visits[i * 2]);
+    send_to_char(buf, ch);
+  }
+  sprintf(buf, "%ld trees grown.\n\r", h_tree_built - built);
+  send_to_char(buf, ch);
+  if ( wrong > 0 )
+  {
+    sprintf(buf, "%d steps disagreed on the distance; see the log.\n\r",
+            wrong);
+    send_to_char(buf, ch);
+  }
+  for ( i = 0; i < 3; i++ )
+    h_visits[i] = visits[i];
+  h_tree_built = built;
+  return;
+}
+
+/*
+ * huntstat: what pathfinding has cost, and ways to try the searches.
+ * 'huntstat trees', 'huntstat areas' and 'huntstat bidir' switch them.  'huntstat bench
+ * [n]' hunts between n pairs of random rooms anywhere in the world
+ * through any door - about as bad as hunting gets - both ways, and
+ * checks the two agree on how far it is.  'huntstat chase' is above.
+ */
+void do_huntstat( CHAR_DATA *ch, char *argument )
 {
-  struct h_queue *bucket;
-  int bcnt;
+  static char * const kind[3] = { "one way", "both ways", "trees" };
+  char arg[MAX_INPUT_LENGTH];
+  char buf[MAX_STRING_LENGTH];
+  ROOM_INDEX_DATA **rooms;
+  ROOM_INDEX_DATA *room;
+  long long took[2];
+  long long worst[2];
+  long long start;
+  long visits[2];
+  int dist[2];
+  int nrooms = 0;
+  int found = 0;
+  int wrong = 0;
+  int iHash;
+  int n;
+  int i;
+
+  argument = one_argument(argument, arg);
+  if ( !str_cmp(arg, "bidir") )
+  {
+    hunt_bidir = !hunt_bidir;
+    sprintf(buf, "HUNT_WORLD searches now go %s.\n\r",
+            kind[hunt_bidir ? 1 : 0]);
+    send_to_char(buf, ch);
+    return;
+  }
+
+  if ( !str_cmp(arg, "areas") )
+  {
+    hunt_areas = !hunt_areas;
+    send_to_char(hunt_areas ? "Hunting now checks the area map first.\n\r"
+                            : "Hunting now ignores the area map.\n\r", ch);
+    return;
+  }
 
-  bucket = getmem(MAX_BUCKET_SIZE*sizeof(*bucket));
-  for ( bcnt = 0; bcnt < MAX_BUCKET_SIZE; bcnt++ )
-    bucket[bcnt].next = (bcnt < TOP_BUCKET_LIST ? &bucket[bcnt+1] : h_free);
-  h_free = &bucket[0];
+  if ( !str_cmp(arg, "trees") )
+  {
+    hunt_trees = !hunt_trees;
+    send_to_char(hunt_trees ? "Hunting now uses the next-hop trees.\n\r"
+                            : "Hunting now searches every step.\n\r", ch);
+    return;
+  }
+
+  if ( str_cmp(arg, "bench") && str_cmp(arg, "chase") )
+  {
+    for ( i = 0; i < 3; i++ )
+    {
+      sprintf(buf, "%-9s %8ld searches, %9ld rooms, %6lld usec each\n\r",
+              kind[i], h_searches[i], h_visits[i],
+              h_usec[i] / UMAX(1, h_searches[i]));
+      send_to_char(buf, ch);
+    }
+    for ( i = n = 0; i < HUNT_TREE_CACHE; i++ )
+      if ( h_trees[i].target != NULL )
+        n++;
+    sprintf(buf, "%d trees in use, %ld grown, %ld thrown away.\n\r",
+            n, h_tree_built, h_tree_dropped);
+    send_to_char(buf, ch);
+    sprintf(buf, "Area map %s: %d areas, %d borders crossed, %ld hunts "
+            "given up on.\n\r", (hunt_areas ? "on" : "off"),
+            UMAX(0, h_areas - 1), h_area_links, h_area_cuts);
+    send_to_char(buf, ch);
+    sprintf(buf, "%d rooms have ids; HUNT_WORLD searches go %s%s.\n\r",
+            h_top_id, kind[hunt_bidir ? 1 : 0],
+            hunt_trees ? " when the trees are off" : "");
+    send_to_char(buf, ch);
+    return;
+  }
+
+  rooms = getmem(top_room * sizeof(*rooms));
+  for ( iHash = 0; iHash < MAX_KEY_HASH; iHash++ )
+    for ( room = room_index_hash[iHash]; room; room = room->next )
+      if ( nrooms < top_room )
+        rooms[nrooms++] = room;
+
+  if ( !str_cmp(arg, "chase") )
+  {
+    one_argument(argument, arg);
+    n = (is_number(arg) ? URANGE(1, atoi(arg), 1000) : 100);
+    if ( nrooms > 1 )
+      h_chase(ch, rooms, nrooms, n);
+    dispose(rooms, top_room * sizeof(*rooms));
+    return;
+  }
+
+  one_argument(argument, arg);
+  n = (is_number(arg) ? URANGE(1, atoi(arg), 10000) : 100);
+
+  visits[0] = h_visits[0];
+  visits[1] = h_visits[1];
+  took[0] = took[1] = worst[0] = worst[1] = 0;
+  for ( i = 0; i < n && nrooms > 1; i++ )
+  {
+    ROOM_INDEX_DATA *from = rooms[number_range(0, nrooms - 1)];
+    ROOM_INDEX_DATA *to   = rooms[number_range(0, nrooms - 1)];
+
+    if ( from == to )
+      continue;
+    start = current_usec();
+    dist[0] = (h_search_from(from, to, HUNT_WORLD|HUNT_ALL) < 0 ? -1 : h_last_dist);
+    start = current_usec() - start;
+    took[0] += start;
+    worst[0] = UMAX(worst[0], start);
+
+    start = current_usec();
+    dist[1] = (h_search_both(from, to, HUNT_WORLD|HUNT_ALL) < 0 ? -1 : h_last_dist);
+    start = current_usec() - start;
+    took[1] += start;
+    worst[1] = UMAX(worst[1], start);
+
+    if ( dist[0] >= 0 )
+      found++;
+    if ( dist[0] != dist[1] )
+    {
+      wrong++;
+      bugf("huntstat: %d to %d is %d steps one way, %d both ways.",
+           from->vnum, to->vnum, dist[0], dist[1]);
+    }
+  }
+  dispose(rooms, top_room * sizeof(*rooms));
+
+  sprintf(buf, "%d hunts between random rooms, %d of them possible:\n\r",
+          i, found);
+  send_to_char(buf, ch);
+  for ( n = 0; n < 2; n++ )
+  {
+    sprintf(buf, "%-9s %6lld usec each, worst %6lld, %ld rooms looked at\n\r",
+            kind[n], took[n] / UMAX(1, i), worst[n], h_visits[n] - visits[n]);
+    send_to_char(buf, ch);
+  }
+  if ( wrong > 0 )
+  {
+    sprintf(buf, "%d disagreed on the distance; see the log.\n\r", wrong);
+    send_to_char(buf, ch);
+  }
+  h_visits[0] = visits[0];
+  h_visits[1] = visits[1];
   return;
 }
-#undef TOP_BUCKET_SIZE
-#undef MAX_BUCKET_SIZE
-#endif
@@ -815,6 +815,20 @@ const   struct  cmd_type        cmd_table       [] =
       C_TYPE_IMM, C_SHOW_ALWAYS},
     { "findreset",          do_findreset,      POS_DEAD,       L_HER,  LOG_NORMAL,
       C_TYPE_IMM, C_SHOW_ALWAYS},
+    { "dnscache",       do_dnscache,    POS_DEAD,    L_GOD,  LOG_NORMAL,
+      C_TYPE_IMM, C_SHOW_ALWAYS},
+    { "schedstat",      do_schedstat,   POS_DEAD,    L_GOD,  LOG_NORMAL,
+      C_TYPE_IMM, C_SHOW_ALWAYS},
+    { "pulsestat",      do_pulsestat,   POS_DEAD,    L_GOD,  LOG_NORMAL,
+      C_TYPE_IMM, C_SHOW_ALWAYS},
+    { "cmdstat",        do_cmdstat,     POS_DEAD,    L_GOD,  LOG_NORMAL,
+      C_TYPE_IMM, C_SHOW_ALWAYS},
+    { "memstat",        do_memstat,     POS_DEAD,    L_GOD,  LOG_NORMAL,
+      C_TYPE_IMM, C_SHOW_ALWAYS},
+    { "huntstat",       do_huntstat,    POS_DEAD,    L_GOD,  LOG_NORMAL,
+      C_TYPE_IMM, C_SHOW_ALWAYS},
+    { "colourbench",    do_colourbench, POS_DEAD,    L_GOD,  LOG_NORMAL,
+      C_TYPE_IMM, C_SHOW_ALWAYS},
                                                                        
 
 #if 1
@@ -902,6 +916,170 @@ const   struct  cmd_type        cmd_table       [] =
 
 
 
+/*
+ * Command and social lookup.
+ *
+ * Each table gets a trie of its names, built the first time it is
+ * needed.  The node reached by walking the typed word lists every
+ * entry the word is an abbreviation of, in table order, so the old
+ * "first match in the table wins" rule still holds, and finding that
+ * list costs the length of the word rather than the size of the table.
+ * As with the old scan, the first letter must match exactly and the
+ * rest is compared without case.
+ */
+typedef struct name_trie NAME_TRIE;
+
+struct name_trie
+{
+    NAME_TRIE *	child;		/* one letter longer     */
+    NAME_TRIE *	next;		/* same length           */
+    char	c;
+    int		top;
+    int		size;
+    int *	entry;		/* table indices, in table order */
+};
+
+static NAME_TRIE *	cmd_trie;
+static int		cmd_trie_top = -1;	/* index of the "" entry */
+static NAME_TRIE *	social_trie;
+static bool		social_trie_built;
+
+static NAME_TRIE *trie_child( NAME_TRIE **list, char c, bool fCreate )
+{
+    NAME_TRIE *node;
+
+    for ( node = *list; node != NULL; node = node->next )
+	if ( node->c == c )
+	    return node;
+    if ( !fCreate )
+	return NULL;
+
+    node	= getmem( sizeof( *node ) );
+    node->c	= c;
+    node->next	= *list;
+    *list	= node;
+    return node;
+}
+
+static void trie_add( NAME_TRIE **root, const char *name, int index )
+{
+    NAME_TRIE **list = root;
+    NAME_TRIE *node;
+    const char *p;
+
+    for ( p = name; *p != '\0'; p++ )
+    {
+	node = trie_child( list, p == name ? *p : LOWER( *p ), TRUE );
+	if ( node->top >= node->size )
+	{
+	    int *entry;
+
+	    entry = getmem( ( node->size + 4 ) * sizeof( int ) );
+	    if ( node->entry != NULL )
+	    {
+		memcpy( entry, node->entry, node->size * sizeof( int ) );
+		dispose( node->entry, node->size * sizeof( int ) );
+	    }
+	    node->entry = entry;
+	    node->size += 4;
+	}
+	node->entry[node->top++] = index;
+	list = &node->child;
+    }
+    return;
+}
+
+static void trie_free( NAME_TRIE *node )
+{
+    NAME_TRIE *node_next;
+
+    for ( ; node != NULL; node = node_next )
+    {
+	node_next = node->next;
+	trie_free( node->child );
+	if ( node->entry != NULL )
+	    dispose( node->entry, node->size * sizeof( int ) );
+	dispose( node, sizeof( *node ) );
+    }
+    return;
+}
+
+static NAME_TRIE *trie_find( NAME_TRIE *root, const char *word )
+{
+    NAME_TRIE *node = NULL;
+    NAME_TRIE *list = root;
+    const char *p;
+
+    for ( p = word; *p != '\0'; p++ )
+    {
+	if ( ( node = trie_child( &list, p == word ? *p : LOWER( *p ), FALSE ) ) == NULL )
+	    return NULL;
+	list = node->child;
+    }
+    return node;
+}
+
+static void build_cmd_trie( void )
+{
+    for ( cmd_trie_top = 0; cmd_table[cmd_trie_top].name[0] != '\0'; cmd_trie_top++ )
+	trie_add( &cmd_trie, cmd_table[cmd_trie_top].name, cmd_trie_top );
+    return;
+}
+
+/*
+ * Socials can be added and deleted with sedit, which must call this
+ * afterwards.
+ */
+void build_social_trie( void )
+{
+    int social;
+
+    trie_free( social_trie );
+    social_trie = NULL;
+    for ( social = 0; social_table[social].name[0] != '\0'; social++ )
+	trie_add( &social_trie, social_table[social].name, social );
+    social_trie_built = TRUE;
+    return;
+}
+
+/*
+ * The clan, boss, vampire and werewolf gates that used to sit in
+ * interpret's scan of cmd_table.
+ */
+static bool cmd_allowed( CHAR_DATA *ch, int cmd, int trust )
+{
+    /* Stephen Mod:  if level == CLAN_ONLY then for clan member only.
+			      == BOSS_ONLY have to be leader.  
+			      == -3 vamp
+			      == -4 wolf  */
+
+    if ( cmd_table[cmd].level == CLAN_ONLY 
+	 &&  !IS_NPC( ch )
+	 &&  ch->pcdata->clan == 0 )
+	 return FALSE;
+	 
+    if ( cmd_table[cmd].level == BOSS_ONLY
+	 &&  !IS_NPC( ch )
+	 &&  !IS_SET( ch->pcdata->pflags, PFLAG_CLAN_BOSS ) )
+	 return FALSE;
+    
+    if ( cmd_table[cmd].level == VAMP_ONLY
+	 &&  !IS_NPC( ch )
+	 &&  !IS_VAMP( ch )
+	 &&  ( ch->level != L_GOD )   )
+	 return FALSE;
+
+    if ( cmd_table[cmd].level == WOLF_ONLY
+	 &&  !IS_NPC( ch )
+	 &&  !IS_WOLF( ch ) 
+	 &&  ( ch->level != L_GOD )  )
+	 return FALSE;
+
+    return ( cmd_table[cmd].level <= trust || MP_Commands( ch ) );
+}
+
+
+
 /* Log all commands.. rewrite every 5 mins.. */
 void comlog( CHAR_DATA *ch, int cmd, char *args )
 {
@@ -924,6 +1102,352 @@ void comlog( CHAR_DATA *ch, int cmd, char *args )
 
 
 
+/*
+ * Per-command statistics, kept in a table parallel to cmd_table:
+ * how often each command runs, how long it takes, and which arguments
+ * it spends that time on.  Commands run through 'at', 'force' or
+ * 'order' are counted on their own and inside the command that ran
+ * them.  The table is written to CMDSTAT_FILE and cleared once a day.
+ *
+ * Each command tracks up to CMDSTAT_ARG_SLOTS argument strings, kept
+ * in order of total time.  When they're all taken a new argument takes
+ * over the cheapest slot and starts from its calls and time, the
+ * "space saving" way: nothing charged is lost, and a new argument that
+ * keeps coming up climbs past the ones it displaced.  What it took
+ * over is kept in 'over', so its own share is total - over at least.
+ */
+struct cmd_arg_stat
+{
+    long	count;
+    long long	total;
+    long long	max;
+    long long	over;		/* total inherited with the slot */
+    char	arg[CMDSTAT_ARG_LEN];
+};
+
+struct cmd_stat
+{
+    long		count;
+    long long		total;
+    long long		max;
+    int			nargs;
+    struct cmd_arg_stat	*args;		/* costliest first */
+};
+
+static struct cmd_stat *cmd_stat_table;
+static int		cmd_stat_top;
+static time_t		cmd_stat_since;
+static int		cmd_stat_day = -1;
+
+static void cmd_stat_init( void )
+{
+    for ( cmd_stat_top = 0; cmd_table[cmd_stat_top].name[0] != '\0'; cmd_stat_top++ )
+	;
+    cmd_stat_table = getmem( ( cmd_stat_top + 1 ) * sizeof( struct cmd_stat ) );
+    cmd_stat_since = current_time;
+    return;
+}
+
+/*
+ * Charge one call to its argument string.
+ */
+static void cmd_stat_arg( struct cmd_stat *cs, char *argument, long long used )
+{
+    struct cmd_arg_stat as;
+    int i;
+
+    if ( cs->args == NULL )
+	cs->args = getmem( CMDSTAT_ARG_SLOTS * sizeof( struct cmd_arg_stat ) );
+
+    for ( i = 0; i < cs->nargs; i++ )
+	if ( !strncmp( cs->args[i].arg, argument, CMDSTAT_ARG_LEN - 1 ) )
+	    break;
+    if ( i >= cs->nargs )
+    {
+	if ( cs->nargs < CMDSTAT_ARG_SLOTS )
+	{
+	    i = cs->nargs++;
+	    memset( &cs->args[i], 0, sizeof( struct cmd_arg_stat ) );
+	}
+	else
+	{
+	    i = CMDSTAT_ARG_SLOTS - 1;	/* the cheapest */
+	    cs->args[i].over = cs->args[i].total;
+	    cs->args[i].max  = 0;
+	}
+	strncpy( cs->args[i].arg, argument, CMDSTAT_ARG_LEN - 1 );
+	cs->args[i].arg[CMDSTAT_ARG_LEN - 1] = '\0';
+    }
+
+    cs->args[i].count++;
+    cs->args[i].total += used;
+    if ( used > cs->args[i].max )
+	cs->args[i].max = used;
+
+    as = cs->args[i];
+    for ( ; i > 0 && cs->args[i - 1].total < as.total; i-- )
+	cs->args[i] = cs->args[i - 1];
+    cs->args[i] = as;
+    return;
+}
+
+static void cmd_stat_record( int cmd, char *argument, long long start )
+{
+    struct cmd_stat *cs;
+    long long used = current_usec( ) - start;
+
+    if ( cmd_stat_table == NULL )
+	cmd_stat_init( );
+    if ( cmd < 0 || cmd >= cmd_stat_top )
+	return;
+    cs = &cmd_stat_table[cmd];
+
+    if ( used < 0 )
+	used = 0;
+    cs->count++;
+    cs->total += used;
+    if ( used > cs->max )
+	cs->max = used;
+    cmd_stat_arg( cs, argument, used );
+    return;
+}
+
+static void cmd_stat_reset( void )
+{
+    struct cmd_stat *cs;
+
+    if ( cmd_stat_table == NULL )
+	cmd_stat_init( );
+    for ( cs = cmd_stat_table; cs < cmd_stat_table + cmd_stat_top; cs++ )
+    {
+	cs->count = 0;
+	cs->total = 0;
+	cs->max = 0;
+	cs->nargs = 0;
+    }
+    cmd_stat_since = current_time;
+    return;
+}
+
+static int cmd_stat_key;		/* what cmd_stat_compare sorts by */
+
+#define CMDSTAT_BY_TOTAL	0
+#define CMDSTAT_BY_CALLS	1
+#define CMDSTAT_BY_MAX		2
+#define CMDSTAT_BY_AVG		3
+
+static int cmd_stat_compare( const void *a, const void *b )
+{
+    struct cmd_stat *x = &cmd_stat_table[*(const int *) a];
+    struct cmd_stat *y = &cmd_stat_table[*(const int *) b];
+    double vx, vy;
+
+    switch ( cmd_stat_key )
+    {
+    default:
+    case CMDSTAT_BY_TOTAL: vx = x->total; vy = y->total; break;
+    case CMDSTAT_BY_CALLS: vx = x->count; vy = y->count; break;
+    case CMDSTAT_BY_MAX:   vx = x->max;   vy = y->max;   break;
+    case CMDSTAT_BY_AVG:
+	vx = x->count ? (double) x->total / x->count : 0.0;
+	vy = y->count ? (double) y->total / y->count : 0.0;
+	break;
+    }
+    return vx < vy ? 1 : vx > vy ? -1 : 0;
+}
+
+/*
+ * Fill order[] with the commands that have run, sorted by key.
+ */
+static int cmd_stat_sort( int *order, int key )
+{
+    int cmd;
+    int n = 0;
+
+    for ( cmd = 0; cmd < cmd_stat_top; cmd++ )
+	if ( cmd_stat_table[cmd].count > 0 )
+	    order[n++] = cmd;
+    cmd_stat_key = key;
+    qsort( order, n, sizeof( int ), cmd_stat_compare );
+    return n;
+}
+
+static char *cmd_stat_header =
+    "Command         Calls   Total(ms)   Avg(us)   Max(us)  Costliest argument\n\r";
+
+static void cmd_stat_line( int cmd, char *buf )
+{
+    struct cmd_stat *cs = &cmd_stat_table[cmd];
+
+    sprintf( buf, "%-12s %8ld %11.1f %9.1f %9lld  %s\n\r",
+	cmd_table[cmd].name, cs->count, cs->total / 1000.0,
+	cs->count ? (double) cs->total / cs->count : 0.0, cs->max,
+	cs->nargs == 0 ? "" : cs->args[0].arg[0] != '\0' ? cs->args[0].arg : "(none)" );
+    return;
+}
+
+/*
+ * The same columns for one argument of a command.
+ */
+static void cmd_stat_arg_line( struct cmd_arg_stat *as, char *buf )
+{
+    char over[MAX_INPUT_LENGTH];
+
+    over[0] = '\0';
+    if ( as->over > 0 )
+	sprintf( over, "  (%lldus taken over)", as->over );
+    sprintf( buf, "%-12s %8ld %11.1f %9.1f %9lld  %s%s\n\r",
+	"", as->count, as->total / 1000.0,
+	as->count ? (double) as->total / as->count : 0.0, as->max,
+	as->arg[0] != '\0' ? as->arg : "(none)", over );
+    return;
+}
+
+/*
+ * Write the whole table, slowest commands first, to fp.
+ */
+static void cmd_stat_write( FILE *fp )
+{
+    char buf[MAX_STRING_LENGTH];
+    int *order;
+    int n, i, j;
+
+    order = getmem( cmd_stat_top * sizeof( int ) );
+    n = cmd_stat_sort( order, CMDSTAT_BY_TOTAL );
+    fprintf( fp, "%.24s :: command statistics since %.24s\n",
+	ctime( &current_time ), ctime( &cmd_stat_since ) );
+    fprintf( fp, "%.*s\n", (int) strlen( cmd_stat_header ) - 2, cmd_stat_header );
+    for ( i = 0; i < n; i++ )
+    {
+	cmd_stat_line( order[i], buf );
+	fprintf( fp, "%.*s\n", (int) strlen( buf ) - 2, buf );
+	for ( j = 0; j < CMDSTAT_ARGS && j < cmd_stat_table[order[i]].nargs; j++ )
+	{
+	    cmd_stat_arg_line( &cmd_stat_table[order[i]].args[j], buf );
+	    fprintf( fp, "%.*s\n", (int) strlen( buf ) - 2, buf );
+	}
+    }
+    fprintf( fp, "\n" );
+    dispose( order, cmd_stat_top * sizeof( int ) );
+    return;
+}
+
+/*
+ * Append the whole table to CMDSTAT_FILE.
+ */
+static bool cmd_stat_save( void )
+{
+    FILE *fp;
+
+    if ( cmd_stat_table == NULL )
+	cmd_stat_init( );
+    if ( ( fp = fopen( CMDSTAT_FILE, "a" ) ) == NULL )
+    {
+	bug( "cmd_stat_save: couldn't open " CMDSTAT_FILE, 0 );
+	return FALSE;
+    }
+    cmd_stat_write( fp );
+    fclose( fp );
+    return TRUE;
+}
+
+/*
+ * Called once a tick: on the first tick of a new day, write out the
+ * previous day's numbers and start again.
+ */
+void cmd_stat_update( void )
+{
+    struct tm *now = localtime( &current_time );
+
+    if ( cmd_stat_day == -1 )
+    {
+	cmd_stat_day = now->tm_yday;
+	return;
+    }
+    if ( now->tm_yday == cmd_stat_day )
+	return;
+    cmd_stat_day = now->tm_yday;
+    cmd_stat_save( );
+    cmd_stat_reset( );
+    return;
+}
+
+void do_cmdstat( CHAR_DATA *ch, char *argument )
+{
+    char buf[MAX_STRING_LENGTH];
+    char arg[MAX_INPUT_LENGTH];
+    int *order;
+    int key = CMDSTAT_BY_TOTAL;
+    int n, i, cmd;
+
+    if ( cmd_stat_table == NULL )
+	cmd_stat_init( );
+    one_argument( argument, arg );
+
+    if ( !str_cmp( arg, "reset" ) )
+    {
+	cmd_stat_reset( );
+	send_to_char( "Command statistics reset.\n\r", ch );
+	return;
+    }
+
+    if ( !str_cmp( arg, "save" ) )
+    {
+	if ( cmd_stat_save( ) )
+	    send_to_char( "Command statistics written to " CMDSTAT_FILE ".\n\r", ch );
+	else
+	    send_to_char( "Couldn't open the cmdstat file.\n\r", ch );
+	return;
+    }
+
+    if ( arg[0] == '\0' || !str_cmp( arg, "total" ) )
+	key = CMDSTAT_BY_TOTAL;
+    else if ( !str_cmp( arg, "calls" ) )
+	key = CMDSTAT_BY_CALLS;
+    else if ( !str_cmp( arg, "max" ) )
+	key = CMDSTAT_BY_MAX;
+    else if ( !str_cmp( arg, "avg" ) )
+	key = CMDSTAT_BY_AVG;
+    else
+    {
+	/* A single command, with all the arguments it has tracked. */
+	for ( cmd = 0; cmd < cmd_stat_top; cmd++ )
+	    if ( !str_cmp( arg, cmd_table[cmd].name ) )
+		break;
+	if ( cmd >= cmd_stat_top )
+	{
+	    send_to_char( "Syntax: cmdstat [total|calls|max|avg|reset|save]\n\r", ch );
+	    send_to_char( "        cmdstat <command>\n\r", ch );
+	    return;
+	}
+	send_to_char( cmd_stat_header, ch );
+	cmd_stat_line( cmd, buf );
+	send_to_char( buf, ch );
+	for ( i = 0; i < cmd_stat_table[cmd].nargs; i++ )
+	{
+	    cmd_stat_arg_line( &cmd_stat_table[cmd].args[i], buf );
+	    send_to_char( buf, ch );
+	}
+	return;
+    }
+
+    order = getmem( cmd_stat_top * sizeof( int ) );
+    n = cmd_stat_sort( order, key );
+    sprintf( buf, "Command statistics since %.24s, %d commands used.\n\r\n\r",
+	ctime( &cmd_stat_since ), n );
+    send_to_char( buf, ch );
+    send_to_char( cmd_stat_header, ch );
+    for ( i = 0; i < n && i < CMDSTAT_SHOW; i++ )
+    {
+	cmd_stat_line( order[i], buf );
+	send_to_char( buf, ch );
+    }
+    dispose( order, cmd_stat_top * sizeof( int ) );
+    return;
+}
+
+
+
 /*
  * The main entry point for executing commands.
  * Can be recursively called from 'at', 'order', 'force'.
@@ -939,7 +1463,11 @@ void interpret( CHAR_DATA *ch, char *argument )
     bool alias_call;
     char command[MAX_INPUT_LENGTH];
     char logline[MAX_INPUT_LENGTH];
+    char statarg[CMDSTAT_ARG_LEN];
+    long long start;
+    NAME_TRIE *node;
     int cmd;
+    int i;
     int trust;
     bool found;
 
@@ -1026,56 +1554,20 @@ void interpret( CHAR_DATA *ch, char *argument )
     /*
      * Look for command in command table.
      */
+    if ( cmd_trie_top < 0 )
+	build_cmd_trie( );
     found = FALSE;
     trust = get_trust( ch );
-    for ( cmd = 0; cmd_table[cmd].name[0] != '\0'; cmd++ )
+    cmd = cmd_trie_top;
+    if ( ( node = trie_find( cmd_trie, command ) ) != NULL )
     {
-	
-	/* Stephen Mod:  if level == CLAN_ONLY then for clan member only.
-				  == BOSS_ONLY have to be leader.  
-                                  == -3 vamp
-                                  == -4 wolf  */
-	
-	if ( cmd_table[cmd].level == CLAN_ONLY 
-	     &&  !IS_NPC( ch )
-	     &&  ch->pcdata->clan == 0 )
-	     continue;
-	     
-	if ( cmd_table[cmd].level == BOSS_ONLY
-	     &&  !IS_NPC( ch )
-	     &&  !IS_SET( ch->pcdata->pflags, PFLAG_CLAN_BOSS ) )
-	     continue;
-	
-	if ( cmd_table[cmd].level == VAMP_ONLY
-	     &&  !IS_NPC( ch )
-	     &&  !IS_VAMP( ch )
-             &&  ( ch->level != L_GOD )   )
-	     continue;
-
-	if ( cmd_table[cmd].level == WOLF_ONLY
-	     &&  !IS_NPC( ch )
-	     &&  !IS_WOLF( ch ) 
-             &&  ( ch->level != L_GOD )  )
-	     continue;
-	
-	
-	
-	if ( command[0] == cmd_table[cmd].name[0]
-	&&   !str_prefix( command, cmd_table[cmd].name )
-	&&   ( cmd_table[cmd].level <= trust
-	      || MP_Commands( ch ) ) )
-	{
-	
-	   
-	
-	    found = TRUE;
-	    break;
-	}
-    
-	
-    
-    
-    
+	for ( i = 0; i < node->top; i++ )
+	    if ( cmd_allowed( ch, node->entry[i], trust ) )
+	    {
+		cmd = node->entry[i];
+		found = TRUE;
+		break;
+	    }
     }
 
     /*
@@ -1198,7 +1690,12 @@ void interpret( CHAR_DATA *ch, char *argument )
       act( "$n steps out of the Shadows!", ch, NULL, NULL, TO_ROOM );
     }
     comlog(ch, cmd, argument);
+    strncpy( statarg, cmd_table[cmd].log == LOG_NEVER ? "XXX" : argument,
+	CMDSTAT_ARG_LEN - 1 );
+    statarg[CMDSTAT_ARG_LEN - 1] = '\0';
+    start = current_usec( );
     (*cmd_table[cmd].do_fun) ( ch, argument );
+    cmd_stat_record( cmd, statarg, start );
 
     tail_chain( );
     return;
@@ -1210,22 +1707,14 @@ bool check_social( CHAR_DATA *ch, char *command, char *argument )
 {
     char arg[MAX_INPUT_LENGTH];
     CHAR_DATA *victim;
+    NAME_TRIE *node;
     int cmd;
-    bool found;
 
-    found  = FALSE;
-    for ( cmd = 0; social_table[cmd].name[0] != '\0'; cmd++ )
-    {
-	if ( command[0] == social_table[cmd].name[0]
-	&&   !str_prefix( command, social_table[cmd].name ) )
-	{
-	    found = TRUE;
-	    break;
-	}
-    }
-
-    if ( !found )
+    if ( !social_trie_built )
+	build_social_trie( );
+    if ( ( node = trie_find( social_trie, command ) ) == NULL )
 	return FALSE;
+    cmd = node->entry[0];
 
     if ( !IS_NPC(ch) && IS_SET(ch->act, PLR_NO_EMOTE) )
     {
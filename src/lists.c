@@ -82,6 +82,10 @@ BUF_DATA_STRUCT * first_buf=NULL;
 BUF_DATA_STRUCT * last_buf = NULL;
 NPC_GROUP_DATA * first_npc_group = NULL;
 NPC_GROUP_DATA * last_npc_group = NULL;
+ROOM_INDEX_DATA *	first_hot_room = NULL;
+ROOM_INDEX_DATA *	last_hot_room = NULL;
+CHAR_DATA *		first_mpact_ch = NULL;
+CHAR_DATA *		last_mpact_ch = NULL;
 
 
 
@@ -128,6 +132,51 @@ MESSAGE_DATA *	message_free = NULL;
 BUF_DATA_STRUCT * buf_free = NULL;
 HASH_ENTRY * hash_free = NULL;
 NPC_GROUP_DATA * npc_group_free = NULL;
+OUT_QUEUE * outq_free = NULL;
+
+SLAB_TYPE portal_free_slab = { "portal" };
+SLAB_TYPE affect_free_slab = { "affect" };
+SLAB_TYPE raffect_free_slab = { "raffect" };
+SLAB_TYPE area_free_slab = { "area" };
+SLAB_TYPE ban_free_slab = { "ban" };
+SLAB_TYPE char_free_slab = { "char" };
+SLAB_TYPE desc_free_slab = { "desc" };
+SLAB_TYPE exit_free_slab = { "exit" };
+SLAB_TYPE exdesc_free_slab = { "exdesc" };
+SLAB_TYPE help_free_slab = { "help" };
+SLAB_TYPE mid_free_slab = { "mid" };
+SLAB_TYPE note_free_slab = { "note" };
+SLAB_TYPE obj_free_slab = { "obj" };
+SLAB_TYPE oid_free_slab = { "oid" };
+SLAB_TYPE pcd_free_slab = { "pcd" };
+SLAB_TYPE reset_free_slab = { "reset" };
+SLAB_TYPE rid_free_slab = { "rid" };
+SLAB_TYPE shop_free_slab = { "shop" };
+SLAB_TYPE mprog_free_slab = { "mprog" };
+SLAB_TYPE mpact_free_slab = { "mpact" };
+SLAB_TYPE build_free_slab = { "build" };
+SLAB_TYPE shield_free_slab = { "shield" };
+SLAB_TYPE member_free_slab = { "member" };
+SLAB_TYPE corpse_free_slab = { "corpse" };
+SLAB_TYPE mark_free_slab = { "mark" };
+SLAB_TYPE mark_list_free_slab = { "mark_list" };
+SLAB_TYPE interact_free_slab = { "interact" };
+SLAB_TYPE influence_free_slab = { "influence" };
+SLAB_TYPE ruler_data_free_slab = { "ruler_data" };
+SLAB_TYPE control_data_free_slab = { "control_data" };
+SLAB_TYPE control_list_free_slab = { "control_list" };
+SLAB_TYPE queued_interact_free_slab = { "queued_interact" };
+SLAB_TYPE influence_list_free_slab = { "influence_list" };
+SLAB_TYPE ruler_list_free_slab = { "ruler_list" };
+SLAB_TYPE dl_list_free_slab = { "dl_list" };
+SLAB_TYPE brand_data_free_slab = { "brand_data" };
+SLAB_TYPE money_type_free_slab = { "money_type" };
+SLAB_TYPE board_free_slab = { "board" };
+SLAB_TYPE message_free_slab = { "message" };
+SLAB_TYPE buf_free_slab = { "buf" };
+SLAB_TYPE hash_free_slab = { "hash" };
+SLAB_TYPE npc_group_free_slab = { "npc_group" };
+SLAB_TYPE outq_free_slab = { "outq" };
 
 
 void (*portal_free_destructor )          ( PORTAL_DATA * pdat ) = NULL;
@@ -156,6 +205,7 @@ void (*money_type_free_destructor )      ( MONEY_TYPE * mtdat ) = NULL;
 void (*board_free_destructor )           ( BOARD_DATA * bdat ) = NULL;
 void (*buf_free_destructor )             ( BUF_DATA_STRUCT * bdat ) = NULL;
 void (*hash_free_destructor )            ( HASH_ENTRY * hdat )= NULL;
+void (*outq_free_destructor )            ( OUT_QUEUE * oqdat )= NULL;
 
 
 
@@ -338,3 +388,55 @@ void npc_group_free_destructor( NPC_GROUP_DATA * ngrp )
     free_string( ngrp->wants );
     free_string( ngrp->needs );
 }
+
+/*
+ * Give back slabs that have stood empty a while.  Every freelist needs
+ * to be here.
+ */
+void slab_trim_all( void )
+{
+    SLAB_TRIM( portal_free );
+    SLAB_TRIM( affect_free );
+    SLAB_TRIM( raffect_free );
+    SLAB_TRIM( area_free );
+    SLAB_TRIM( ban_free );
+    SLAB_TRIM( char_free );
+    SLAB_TRIM( desc_free );
+    SLAB_TRIM( exit_free );
+    SLAB_TRIM( exdesc_free );
+    SLAB_TRIM( help_free );
+    SLAB_TRIM( mid_free );
+    SLAB_TRIM( note_free );
+    SLAB_TRIM( obj_free );
+    SLAB_TRIM( oid_free );
+    SLAB_TRIM( pcd_free );
+    SLAB_TRIM( reset_free );
+    SLAB_TRIM( rid_free );
+    SLAB_TRIM( shop_free );
+    SLAB_TRIM( mprog_free );
+    SLAB_TRIM( mpact_free );
+    SLAB_TRIM( build_free );
+    SLAB_TRIM( shield_free );
+    SLAB_TRIM( member_free );
+    SLAB_TRIM( corpse_free );
+    SLAB_TRIM( mark_free );
+    SLAB_TRIM( mark_list_free );
+    SLAB_TRIM( interact_free );
+    SLAB_TRIM( influence_free );
+    SLAB_TRIM( ruler_data_free );
+    SLAB_TRIM( control_data_free );
+    SLAB_TRIM( control_list_free );
+    SLAB_TRIM( queued_interact_free );
+    SLAB_TRIM( influence_list_free );
+    SLAB_TRIM( ruler_list_free );
+    SLAB_TRIM( dl_list_free );
+    SLAB_TRIM( brand_data_free );
+    SLAB_TRIM( money_type_free );
+    SLAB_TRIM( board_free );
+    SLAB_TRIM( message_free );
+    SLAB_TRIM( buf_free );
+    SLAB_TRIM( hash_free );
+    SLAB_TRIM( npc_group_free );
+    SLAB_TRIM( outq_free );
+    return;
+}
@@ -75,6 +75,10 @@ extern  BUF_DATA_STRUCT * first_buf;
 extern  BUF_DATA_STRUCT * last_buf;
 extern  NPC_GROUP_DATA * first_npc_group;
 extern NPC_GROUP_DATA * last_npc_group;
+extern	ROOM_INDEX_DATA *	first_hot_room;
+extern	ROOM_INDEX_DATA *	last_hot_room;
+extern	CHAR_DATA *		first_mpact_ch;
+extern	CHAR_DATA *		last_mpact_ch;
 
 extern	PORTAL_DATA *		portal_free;
 extern	AFFECT_DATA *		affect_free;
@@ -118,6 +122,52 @@ extern MESSAGE_DATA *	message_free;
 extern BUF_DATA_STRUCT * buf_free;
 extern HASH_ENTRY * hash_free;
 extern NPC_GROUP_DATA * npc_group_free;
+extern OUT_QUEUE * outq_free;
+
+/* where each freelist's objects come from, see slab.c */
+extern SLAB_TYPE portal_free_slab;
+extern SLAB_TYPE affect_free_slab;
+extern SLAB_TYPE raffect_free_slab;
+extern SLAB_TYPE area_free_slab;
+extern SLAB_TYPE ban_free_slab;
+extern SLAB_TYPE char_free_slab;
+extern SLAB_TYPE desc_free_slab;
+extern SLAB_TYPE exit_free_slab;
+extern SLAB_TYPE exdesc_free_slab;
+extern SLAB_TYPE help_free_slab;
+extern SLAB_TYPE mid_free_slab;
+extern SLAB_TYPE note_free_slab;
+extern SLAB_TYPE obj_free_slab;
+extern SLAB_TYPE oid_free_slab;
+extern SLAB_TYPE pcd_free_slab;
+extern SLAB_TYPE reset_free_slab;
+extern SLAB_TYPE rid_free_slab;
+extern SLAB_TYPE shop_free_slab;
+extern SLAB_TYPE mprog_free_slab;
+extern SLAB_TYPE mpact_free_slab;
+extern SLAB_TYPE build_free_slab;
+extern SLAB_TYPE shield_free_slab;
+extern SLAB_TYPE member_free_slab;
+extern SLAB_TYPE corpse_free_slab;
+extern SLAB_TYPE mark_free_slab;
+extern SLAB_TYPE mark_list_free_slab;
+extern SLAB_TYPE interact_free_slab;
+extern SLAB_TYPE influence_free_slab;
+extern SLAB_TYPE ruler_data_free_slab;
+extern SLAB_TYPE control_data_free_slab;
+extern SLAB_TYPE control_list_free_slab;
+extern SLAB_TYPE queued_interact_free_slab;
+extern SLAB_TYPE influence_list_free_slab;
+extern SLAB_TYPE ruler_list_free_slab;
+extern SLAB_TYPE dl_list_free_slab;
+extern SLAB_TYPE brand_data_free_slab;
+extern SLAB_TYPE money_type_free_slab;
+extern SLAB_TYPE board_free_slab;
+extern SLAB_TYPE message_free_slab;
+extern SLAB_TYPE buf_free_slab;
+extern SLAB_TYPE hash_free_slab;
+extern SLAB_TYPE npc_group_free_slab;
+extern SLAB_TYPE outq_free_slab;
 
 extern void (*portal_free_destructor )          ( PORTAL_DATA * pdat );
 extern void (*affect_free_destructor )          ( AFFECT_DATA * adat );
@@ -145,6 +195,7 @@ extern void (*money_type_free_destructor )      ( MONEY_TYPE * mtdat );
 extern void (*board_free_destructor )           ( BOARD_DATA * bdat );
 extern void (*buf_free_destructor )             ( BUF_DATA_STRUCT * bdat );
 extern void (*hash_free_destructor )            ( HASH_ENTRY * hdat );
+extern void (*outq_free_destructor )            ( OUT_QUEUE * oqdat );
 
 /* actual destructors */
 void note_free_destructor ( NOTE_DATA * ndat );
@@ -174,7 +225,7 @@ void npc_group_free_destructor( NPC_GROUP_DATA * ngrp );
 #define GET_FREE(item, freelist) \
 do { \
   if ( !(freelist) ) \
-    (item) = getmem(sizeof(*(item))); \
+    (item) = slab_alloc(&freelist##_slab, sizeof(*(item)), _caller); \
   else { \
     if ( !(freelist)->is_free ) { \
       bug("GET_FREE: freelist head is NOT FREE!  Hanging...", 0); \
@@ -182,6 +233,7 @@ do { \
     } \
     (item) = (freelist); \
     (freelist) = (item)->next; \
+    slab_get((item), _caller); \
     memset((item), 0, sizeof(*(item))); /* This clears is_free flag */ \
   } \
 } while(0)
@@ -195,8 +247,15 @@ do { \
   (item)->next = (freelist); \
   (item)->is_free = TRUE; /* This sets is_free flag */ \
   (freelist) = (item); \
+  slab_put((item), (char *) &(item)->next - (char *) (item)); \
   if (freelist##_destructor) freelist##_destructor(item); \
 } while(0)
 
+#define SLAB_TRIM(freelist) \
+do { \
+  if ( (freelist) ) \
+    slab_trim(&freelist##_slab, (void **) &(freelist)); \
+} while(0)
+
 
 
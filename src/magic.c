@@ -94,7 +94,7 @@ int mana_cost( CHAR_DATA * ch, int sn)
     && ( IS_NPC( ch ) )  )
  {
    if (  ( IS_SET( ch->act, ACT_INTELLIGENT ) )
-      && ( sn == skill_lookup( "ethereal" ) ) )
+      && ( sn == gsn_ethereal_travel ) )
    {
      return 150;
    }
@@ -160,21 +160,60 @@ int mana_cost( CHAR_DATA * ch, int sn)
 
 /*
  * Lookup a skill by name.
+ * skill_table never changes, so each answer is kept in a small hash
+ * keyed on the lowercased name, one per bucket.  A name too long for
+ * a bucket just gets the scan.
  */
+static struct
+{
+    char	name[32];
+    int		sn;
+} skill_hash[SKILL_HASH];
+
 int skill_lookup( const char *name )
 {
+    char key[32];
+    unsigned int hash = 0;
     int sn;
+    int i;
+
+    for ( i = 0; name[i] != '\0'; i++ )
+    {
+	if ( i >= (int) sizeof( key ) - 1 )
+	    break;
+	key[i] = LOWER( name[i] );
+	hash = hash * 31 + (unsigned char) key[i];
+    }
+    key[i] = '\0';
+
+    if ( i > 0 && name[i] == '\0' )
+    {
+	hash %= SKILL_HASH;
+	if ( !strcmp( key, skill_hash[hash].name ) )
+	    return skill_hash[hash].sn;
+    }
 
     for ( sn = 0; sn < MAX_SKILL; sn++ )
     {
 	if ( skill_table[sn].name == NULL )
+	{
+	    sn = -1;
 	    break;
+	}
 	if ( LOWER(name[0]) == LOWER(skill_table[sn].name[0])
 	&&   !str_prefix( name, skill_table[sn].name ) )
-	    return sn;
+	    break;
     }
+    if ( sn >= MAX_SKILL )
+	sn = -1;
 
-    return -1;
+    if ( i > 0 && name[i] == '\0' )
+    {
+	strcpy( skill_hash[hash].name, key );
+	skill_hash[hash].sn = sn;
+    }
+
+    return sn;
 }
 
 
@@ -604,7 +643,7 @@ void do_cast( CHAR_DATA *ch, char *argument )
 	break;
     }
     if (  ( skill_table[sn].flag2 == NORM )
-       && ( is_affected( ch, skill_lookup( "mystical focus" ) )  )  )
+       && ( is_affected( ch, gsn_mystical_focus )  )  )
     {
       mana *= 2.5;
     }
@@ -711,10 +750,10 @@ void do_cast( CHAR_DATA *ch, char *argument )
       mana = mana *2 / 3;
       multi_cast = TRUE;
     }
-    if (  ( sn != skill_lookup( "cure light" ) )
-       && ( sn != skill_lookup( "cure serious" ) )
-       && ( sn != skill_lookup( "cure critical" ) )
-       && ( sn != skill_lookup( "heal" ) )  )
+    if (  ( sn != gsn_cure_light )
+       && ( sn != gsn_cure_serious )
+       && ( sn != gsn_cure_critical )
+       && ( sn != gsn_heal )  )
     {
       sprintf( log_buf, "%s typed %s, Spell %s, room %s(%d), target %s",
         ch->name, typed, skill_table[sn].name,
@@ -760,10 +799,10 @@ void do_cast( CHAR_DATA *ch, char *argument )
       if ( still_here )
       {
         vo = ( void*) victim;
-    if (  ( sn != skill_lookup( "cure light" ) )
-       && ( sn != skill_lookup( "cure serious" ) )
-       && ( sn != skill_lookup( "cure critical" ) )
-       && ( sn != skill_lookup( "heal" ) )  )
+    if (  ( sn != gsn_cure_light )
+       && ( sn != gsn_cure_serious )
+       && ( sn != gsn_cure_critical )
+       && ( sn != gsn_heal )  )
     {
       sprintf( log_buf, "%s typed %s, Spell %s, room %s(%d), target %s",
         ch->name, typed, skill_table[sn].name,
@@ -813,10 +852,10 @@ void do_cast( CHAR_DATA *ch, char *argument )
       if ( still_here )
       {
         vo = ( void*) victim;
-    if (  ( sn != skill_lookup( "cure light" ) )
-       && ( sn != skill_lookup( "cure serious" ) )
-       && ( sn != skill_lookup( "cure critical" ) )
-       && ( sn != skill_lookup( "heal" ) )  )
+    if (  ( sn != gsn_cure_light )
+       && ( sn != gsn_cure_serious )
+       && ( sn != gsn_cure_critical )
+       && ( sn != gsn_heal )  )
     {
       sprintf( log_buf, "%s typed %s, Spell %s, room %s(%d), target %s",
         ch->name, typed, skill_table[sn].name,
@@ -1033,7 +1072,7 @@ bool spell_bark_skin( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj
     CHAR_DATA *victim = (CHAR_DATA *) vo;
     AFFECT_DATA af;
 
-    if ( is_affected( ch, sn ) || is_affected( ch, skill_lookup("stone skin" ) ) )
+    if ( is_affected( ch, sn ) || is_affected( ch, gsn_stone_skin ) )
 	return FALSE;
     af.type      = sn;
     af.duration  = 3 + (level/12);
@@ -1645,7 +1684,7 @@ bool spell_detect_undead( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *
   CHAR_DATA *victim = (CHAR_DATA *) vo;
   AFFECT_DATA af;
   
-  if ( is_affected(victim, skill_lookup( "detect undead" ) ) || item_has_apply(victim,ITEM_APPLY_DET_UNDEAD))
+  if ( is_affected(victim, gsn_detect_undead ) || item_has_apply(victim,ITEM_APPLY_DET_UNDEAD))
      return FALSE; 
   
   af.type       = sn;
@@ -1800,7 +1839,7 @@ bool spell_dispel_magic( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *o
       for ( paf = victim->first_affect; paf != NULL; paf = paf_next )        
       {
 	 paf_next = paf->next;
-         if ( paf->type == skill_lookup( "Enraged" ) )
+         if ( paf->type == gsn_enraged )
            continue;
    if (  ( obj )
       || ( victim == ch->fighting ) )
@@ -2388,7 +2427,7 @@ bool spell_harm( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj )
 	    dam = UMIN( 100, dam / 4 );
     if ( sp_damage( obj, ch, victim, dam, REALM_DRAIN, sn, TRUE ) )
     {
-      af.type      = skill_lookup( "poison" );
+      af.type      = gsn_poison;
       af.duration  = 12 + (level/10);
       af.location  = APPLY_STR;
       af.modifier  = -2;
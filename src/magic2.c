@@ -482,7 +482,7 @@ bool spell_stone_skin( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj
     CHAR_DATA *victim = (CHAR_DATA *) vo;
     AFFECT_DATA af;
 
-    if ( is_affected( ch, sn ) || is_affected( ch, skill_lookup( "stone skin" ) ) )
+    if ( is_affected( ch, sn ) || is_affected( ch, gsn_stone_skin ) )
 	return FALSE;
     af.type      = sn;
     af.duration  = 5 + (level/12);
@@ -1342,7 +1342,7 @@ bool spell_bloody_tears( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *o
 
     act ( "$n's eyes start bleeding!", victim, NULL, NULL, TO_ROOM );
     send_to_char( "Your eyes start bleeding!\n\r", victim );
-    spell_blindness( skill_lookup( "blindness"), level, ch, vo, obj );
+    spell_blindness( gsn_blindness, level, ch, vo, obj );
     
     sp_damage( obj,  ch, victim, (level/2), REALM_MIND | NO_REFLECT | NO_ABSORB, sn, FALSE );		/* -1 = no dam message */
 
@@ -2046,7 +2046,7 @@ bool spell_stalker( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj )
    {
       int sn;
  
-      sn = skill_lookup( "hellspawn" );
+      sn = gsn_hellspawn;
       if ( sn != 0 )	/* Check to be sure... should never == 0 */
          (*skill_table[sn].spell_fun) (sn, stalker->level, stalker, ch, NULL );
 
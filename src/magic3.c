@@ -1758,7 +1758,7 @@ bool spell_lava_burst( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj
       {
         if ( prev_carried != NULL )
         {
-          SET_BIT( prev_carried->item_apply, ITEM_APPLY_HEATED );
+          set_item_apply( prev_carried, ITEM_APPLY_HEATED, TRUE );
           return TRUE;
         }
         else
@@ -1768,7 +1768,7 @@ bool spell_lava_burst( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj
       }
       else
       {
-        SET_BIT( heated_item->item_apply, ITEM_APPLY_HEATED );
+        set_item_apply( heated_item, ITEM_APPLY_HEATED, TRUE );
         return TRUE;
       }
 
@@ -1813,7 +1813,7 @@ bool spell_heat_armor( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj
           if (  ( !IS_NPC( victim ) && IS_WOLF( victim ) )
              && ( !IS_RAGED( victim ) && !IS_SHIFTED( victim ) )  )
 
-          SET_BIT( prev_carried->item_apply, ITEM_APPLY_HEATED );
+          set_item_apply( prev_carried, ITEM_APPLY_HEATED, TRUE );
           return TRUE;
         }
         else
@@ -1826,7 +1826,7 @@ bool spell_heat_armor( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj
           if (  ( !IS_NPC( victim ) && IS_WOLF( victim ) )
              && ( !IS_RAGED( victim ) && !IS_SHIFTED( victim ) )  )
 
-        SET_BIT( heated_item->item_apply, ITEM_APPLY_HEATED );
+        set_item_apply( heated_item, ITEM_APPLY_HEATED, TRUE );
         return TRUE;
       }
 
@@ -1905,7 +1905,7 @@ bool spell_retri_strike( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *o
             {
               if (  ( !IS_NPC( vch ) && IS_WOLF( vch ) )
                  && ( !IS_RAGED( vch ) && !IS_SHIFTED( vch ) )  )
-                SET_BIT( prev_carried->item_apply, ITEM_APPLY_HEATED );
+                set_item_apply( prev_carried, ITEM_APPLY_HEATED, TRUE );
          
             }
         
@@ -1914,7 +1914,7 @@ bool spell_retri_strike( int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *o
           {
               if (  ( !IS_NPC( vch ) && IS_WOLF( vch ) )
                  && ( !IS_RAGED( vch ) && !IS_SHIFTED( vch ) )  )
-                SET_BIT( heated_item->item_apply, ITEM_APPLY_HEATED );
+                set_item_apply( heated_item, ITEM_APPLY_HEATED, TRUE );
           }
         }
         continue;
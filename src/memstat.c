@@ -0,0 +1,323 @@
+/***************************************************************************
+ *  Original Diku Mud copyright (C) 1990, 1991 by Sebastian Hammer,        *
+ *  Michael Seifert, Hans Henrik St{rfeldt, Tom Madsen, and Katja Nyboe.   *
+ *                                                                         *
+ *  Merc Diku Mud improvments copyright (C) 1992, 1993 by Michael          *
+ *  Chastain, Michael Quan, and Mitchell Tse.                              *
+ *                                                                         *
+ *  Ack 2.2 improvements copyright (C) 1994 by Stephen Dooley              *
+ *                                                                         *
+ *  In order to use any part of this Merc Diku Mud, you must comply with   *
+ *  both the original Diku license in 'license.doc' as well the Merc       *
+ *  license in 'license.txt'.  In particular, you may not remove either of *
+ *  these copyright notices.                                               *
+ *                                                                         *
+ *       _/          _/_/_/     _/    _/     _/    ACK! MUD is modified    *
+ *      _/_/        _/          _/  _/       _/    Merc2.0/2.1/2.2 code    *
+ *     _/  _/      _/           _/_/         _/    (c)Stephen Zepp 1998    *
+ *    _/_/_/_/      _/          _/  _/             Version #: 4.3          *
+ *   _/      _/      _/_/_/     _/    _/     _/                            *
+ *                                                                         *
+ *                        http://ackmud.nuc.net/                           *
+ *                        zenithar@ackmud.nuc.net                          *
+ *  Much time and thought has gone into this software and you are          *
+ *  benefitting.  We hope that you share your changes too.  What goes      *
+ *  around, comes around.                                                  *
+ ***************************************************************************/
+/*
+ * memstat.c: who has the memory?
+ *
+ * Every getmem, str_dup and GET_FREE is counted against the site that
+ * made it (its _caller, file:line) and the kind of memory it got.  A
+ * site keeps what it has live now, its peak, and how many allocations
+ * it has made.  'memstat mark' notes where everything stands, so that
+ * later on 'memstat grown' shows what has kept on growing since.
+ *
+ * getmem'd blocks carry their site in a MEM_HEAD in front of them,
+ * freelist objects in their slab header (slab.c), and shared strings
+ * have the caller in their BufEntry already.
+ */
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <time.h>
+#include "ack.h"
+#include "ssm.h"
+
+
+struct mem_site
+{
+    const char *	caller;		/* NULL for an empty slot */
+    int			kind;
+    long		count;		/* live */
+    long		bytes;
+    long		peak;
+    long		allocs;		/* since boot */
+    long		mark_bytes;	/* at the last 'memstat mark' */
+    long		mark_allocs;
+};
+
+/* Slot 0 takes whatever doesn't fit in the table */
+static struct mem_site mem_site_table[MEM_SITES] =
+{
+    { "(other)", MEM_GETMEM }
+};
+static time_t mem_mark_time;
+
+static char * const mem_kind_name[MAX_MEM_KIND] =
+{
+    "getmem", "shared", "overflow", "freelist"
+};
+
+static long mem_kind_bytes[MAX_MEM_KIND];
+static long mem_kind_peak[MAX_MEM_KIND];
+
+/*
+ * In front of every getmem'd block.  Big enough to keep what follows
+ * aligned for anything.
+ */
+typedef union mem_head MEM_HEAD;
+
+union mem_head
+{
+    struct
+    {
+	int	site;
+	int	size;
+    } m;
+    long double	align;
+};
+
+
+
+/*
+ * The slot for caller's allocations of kind.  The same caller always
+ * passes the same string, so the pointer will do as the key.
+ */
+int mem_site( const char *caller, int kind )
+{
+    struct mem_site *ms;
+    unsigned long h;
+    int slot;
+    int n;
+
+    h = ( (unsigned long) caller >> 3 ) * 2654435761UL + kind;
+    slot = (int) ( h & ( MEM_SITES - 1 ) );
+    for ( n = 0; n < MEM_SITES; n++ )
+    {
+	if ( slot == 0 )
+	    slot = 1;
+	ms = &mem_site_table[slot];
+	if ( ms->caller == caller && ms->kind == kind )
+	    return slot;
+	if ( ms->caller == NULL )
+	{
+	    if ( mem_mark_time == 0 )
+		mem_mark_time = current_time;
+	    ms->caller = caller;
+	    ms->kind   = kind;
+	    return slot;
+	}
+	slot = ( slot + 1 ) & ( MEM_SITES - 1 );
+    }
+    return 0;
+}
+
+/*
+ * Count bytes against site: an allocation, or a free if bytes < 0.
+ */
+void mem_count( int site, long bytes )
+{
+    struct mem_site *ms = &mem_site_table[site];
+    int kind = ms->kind;
+
+    ms->bytes += bytes;
+    mem_kind_bytes[kind] += bytes;
+    if ( bytes < 0 )
+    {
+	ms->count--;
+	return;
+    }
+    ms->count++;
+    ms->allocs++;
+    if ( ms->bytes > ms->peak )
+	ms->peak = ms->bytes;
+    if ( mem_kind_bytes[kind] > mem_kind_peak[kind] )
+	mem_kind_peak[kind] = mem_kind_bytes[kind];
+    return;
+}
+
+/*
+ * malloc with a head that says who asked, for getmem and overflow
+ * strings.  mem_put gives it back.
+ */
+void *mem_get( int size, const char *caller, int kind )
+{
+    MEM_HEAD *head;
+
+    if ( ( head = malloc( sizeof( MEM_HEAD ) + size ) ) == NULL )
+    {
+	fprintf( stderr, "Out of memory.\n" );
+	raise( SIGSEGV );
+    }
+    head->m.site = mem_site( caller, kind );
+    head->m.size = size;
+    mem_count( head->m.site, size );
+    return head + 1;
+}
+
+void mem_put( void *mem )
+{
+    MEM_HEAD *head = (MEM_HEAD *) mem - 1;
+
+    mem_count( head->m.site, -(long) head->m.size );
+    free( head );
+    return;
+}
+
+
+
+/*
+ * Compare the shared string sites with what's really in the heap.
+ * Returns how many sites disagree; each is logged.
+ */
+int mem_check_shared( void )
+{
+    static long heap[MEM_SITES];
+    struct mem_site *ms;
+    BufEntry *p;
+    int bad = 0;
+    int i;
+
+    memset( heap, 0, sizeof( heap ) );
+    for ( p = ssm_walk( NULL ); p != NULL; p = ssm_walk( p ) )
+	if ( p->usage > 0 )
+	    heap[mem_site( p->caller, MEM_SHARED )] += p->size + HEADER_SIZE;
+
+    for ( i = 0; i < MEM_SITES; i++ )
+    {
+	ms = &mem_site_table[i];
+	if ( ms->caller == NULL || ms->kind != MEM_SHARED
+	||   ms->bytes == heap[i] )
+	    continue;
+	log_f( "memstat: %s has %ld shared bytes, the heap says %ld.",
+	    ms->caller, ms->bytes, heap[i] );
+	bad++;
+    }
+    return bad;
+}
+
+
+
+static int mem_sort_key;
+
+static long mem_key( const struct mem_site *ms )
+{
+    switch ( mem_sort_key )
+    {
+    default:
+    case 0: return ms->bytes;
+    case 1: return ms->count;
+    case 2: return ms->peak;
+    case 3: return ms->allocs - ms->mark_allocs;
+    case 4: return ms->bytes - ms->mark_bytes;
+    }
+}
+
+static int mem_compare( const void *a, const void *b )
+{
+    long x = mem_key( *(struct mem_site * const *) a );
+    long y = mem_key( *(struct mem_site * const *) b );
+
+    return x > y ? -1 : x < y;
+}
+
+void do_memstat( CHAR_DATA *ch, char *argument )
+{
+    static struct mem_site *order[MEM_SITES];
+    static char * const keys[] =
+    {
+	"bytes", "count", "peak", "rate", "grown", NULL
+    };
+    char buf[MAX_STRING_LENGTH];
+    char arg[MAX_INPUT_LENGTH];
+    struct mem_site *ms;
+    long minutes;
+    int show = MEMSTAT_SHOW;
+    int kind = -1;
+    int n = 0;
+    int i;
+
+    mem_sort_key = 0;
+    for ( argument = one_argument( argument, arg ); arg[0] != '\0';
+	  argument = one_argument( argument, arg ) )
+    {
+	if ( !str_cmp( arg, "mark" ) )
+	{
+	    for ( i = 0; i < MEM_SITES; i++ )
+	    {
+		mem_site_table[i].mark_bytes  = mem_site_table[i].bytes;
+		mem_site_table[i].mark_allocs = mem_site_table[i].allocs;
+	    }
+	    mem_mark_time = current_time;
+	    send_to_char( "Memory statistics marked.\n\r", ch );
+	    return;
+	}
+	if ( !str_cmp( arg, "all" ) )
+	{
+	    show = MEM_SITES;
+	    continue;
+	}
+	for ( i = 0; keys[i] != NULL && str_cmp( arg, keys[i] ); i++ )
+	    ;
+	if ( keys[i] != NULL )
+	{
+	    mem_sort_key = i;
+	    continue;
+	}
+	for ( i = 0; i < MAX_MEM_KIND && str_cmp( arg, mem_kind_name[i] ); i++ )
+	    ;
+	if ( i < MAX_MEM_KIND )
+	{
+	    kind = i;
+	    continue;
+	}
+	send_to_char( "Syntax: memstat [bytes|count|peak|rate|grown] [<kind>] [all]\n\r", ch );
+	send_to_char( "        memstat mark\n\r", ch );
+	send_to_char( "Kinds are getmem, shared, overflow and freelist.\n\r", ch );
+	return;
+    }
+
+    for ( i = 0; i < MAX_MEM_KIND; i++ )
+    {
+	sprintf( buf, "%-9s %10ld bytes live, peak %ld.\n\r",
+	    mem_kind_name[i], mem_kind_bytes[i], mem_kind_peak[i] );
+	send_to_char( buf, ch );
+    }
+
+    for ( i = 0; i < MEM_SITES; i++ )
+	if ( mem_site_table[i].caller != NULL
+	&&   ( kind < 0 || mem_site_table[i].kind == kind ) )
+	    order[n++] = &mem_site_table[i];
+    qsort( order, n, sizeof( order[0] ), mem_compare );
+
+    minutes = UMAX( 1, ( current_time - mem_mark_time ) / 60 );
+    sprintf( buf, "\n\rBy %s; rate and grown are since %.24s.\n\r",
+	keys[mem_sort_key], ctime( &mem_mark_time ) );
+    send_to_char( buf, ch );
+    send_to_char( "Site                      Kind          Live      Bytes"
+		  "       Peak  Allocs/min      Grown\n\r", ch );
+    for ( i = 0; i < n && i < show; i++ )
+    {
+	ms = order[i];
+	sprintf( buf, "%-25.25s %-8s %10ld %10ld %10ld %11ld %10ld\n\r",
+	    ms->caller, mem_kind_name[ms->kind], ms->count, ms->bytes,
+	    ms->peak, ( ms->allocs - ms->mark_allocs ) / minutes,
+	    ms->bytes - ms->mark_bytes );
+	send_to_char( buf, ch );
+    }
+    return;
+}
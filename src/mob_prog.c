@@ -1553,7 +1553,9 @@ void mprog_act_trigger( char *buf, CHAR_DATA *mob, CHAR_DATA *ch,
       tmp_act->obj = obj;
       tmp_act->vo = vo;
       LINK(tmp_act, mob->first_mpact, mob->last_mpact, next, prev);
-      mob->mpactnum++;
+      /* aggr_update only looks at mobs on first_mpact_ch */
+      if ( mob->mpactnum++ == 0 )
+        LINK(mob, first_mpact_ch, last_mpact_ch, next_mpact_ch, prev_mpact_ch);
     }
   return;
 
@@ -0,0 +1,368 @@
+/***************************************************************************
+ *  Original Diku Mud copyright (C) 1990, 1991 by Sebastian Hammer,        *
+ *  Michael Seifert, Hans Henrik St{rfeldt, Tom Madsen, and Katja Nyboe.   *
+ *                                                                         *
+ *  Merc Diku Mud improvments copyright (C) 1992, 1993 by Michael          *
+ *  Chastain, Michael Quan, and Mitchell Tse.                              *
+ *                                                                         *
+ *  Ack 2.2 improvements copyright (C) 1994 by Stephen Dooley              *
+ *                                                                         *
+ *  In order to use any part of this Merc Diku Mud, you must comply with   *
+ *  both the original Diku license in 'license.doc' as well the Merc       *
+ *  license in 'license.txt'.  In particular, you may not remove either of *
+ *  these copyright notices.                                               *
+ *                                                                         *
+ *       _/          _/_/_/     _/    _/     _/    ACK! MUD is modified    *
+ *      _/_/        _/          _/  _/       _/    Merc2.0/2.1/2.2 code    *
+ *     _/  _/      _/           _/_/         _/    (c)Stephen Zepp 1998    *
+ *    _/_/_/_/      _/          _/  _/             Version #: 4.3          *
+ *   _/      _/      _/_/_/     _/    _/     _/                            *
+ *                                                                         *
+ *                        http://ackmud.nuc.net/                           *
+ *                        zenithar@ackmud.nuc.net                          *
+ *  Much time and thought has gone into this software and you are          *
+ *  benefitting.  We hope that you share your changes too.  What goes      *
+ *  around, comes around.                                                  *
+ ***************************************************************************/
+
+/*
+ * netpoll.c: keeps the set of sockets the game loop waits on, so the
+ * loop no longer walks every descriptor to build fd_sets each pulse.
+ * See netpoll.h for the interface.
+ */
+
+#include <sys/types.h>
+#include <sys/time.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "ack.h"
+
+#ifndef DEC_NETPOLL_H
+#include "netpoll.h"
+#endif
+
+#if defined(NETPOLL_EPOLL)
+#include <sys/epoll.h>
+#endif
+
+
+/*
+ * One slot per fd number.  Both backends use it to get from a ready fd
+ * back to its descriptor, and to remember whether we asked for writes.
+ */
+typedef struct netpoll_slot NETPOLL_SLOT;
+
+struct netpoll_slot
+{
+    bool                used;
+    bool                write;
+    DESCRIPTOR_DATA *   d;
+};
+
+NETPOLL_EDGE *		netpoll_ready	= NULL;
+
+static NETPOLL_SLOT *	np_slot		= NULL;
+static int		np_slots	= 0;	/* size of np_slot[]         */
+static int		np_edges	= 0;	/* size of netpoll_ready[]   */
+static int		np_count	= 0;	/* sockets registered        */
+
+#if defined(NETPOLL_EPOLL)
+static int			np_epfd   = -1;
+static struct epoll_event *	np_events = NULL;
+#else
+static fd_set			np_in_set;
+static fd_set			np_out_set;
+static int			np_maxfd  = -1;
+#endif
+
+
+
+/*
+ * Make sure np_slot[] covers fd, and that the ready list can hold an
+ * edge for every registered socket.  Both only ever grow.
+ */
+static void np_grow( int fd )
+{
+    if ( fd >= np_slots )
+    {
+	NETPOLL_SLOT *slot;
+	int size;
+
+	for ( size = UMAX( np_slots, 64 ); size <= fd; size *= 2 )
+	    ;
+	slot = getmem( size * sizeof( NETPOLL_SLOT ) );
+	if ( np_slot != NULL )
+	{
+	    memcpy( slot, np_slot, np_slots * sizeof( NETPOLL_SLOT ) );
+	    dispose( np_slot, np_slots * sizeof( NETPOLL_SLOT ) );
+	}
+	np_slot  = slot;
+	np_slots = size;
+    }
+
+    if ( np_count >= np_edges )
+    {
+	int size = UMAX( np_edges * 2, 64 );
+
+	if ( netpoll_ready != NULL )
+	    dispose( netpoll_ready, np_edges * sizeof( NETPOLL_EDGE ) );
+	netpoll_ready = getmem( size * sizeof( NETPOLL_EDGE ) );
+#if defined(NETPOLL_EPOLL)
+	if ( np_events != NULL )
+	    dispose( np_events, np_edges * sizeof( struct epoll_event ) );
+	np_events = getmem( size * sizeof( struct epoll_event ) );
+#endif
+	np_edges = size;
+    }
+    return;
+}
+
+
+
+#if defined(NETPOLL_EPOLL)
+static bool np_ctl( int op, int fd, bool fWrite )
+{
+    struct epoll_event ev;
+
+    memset( &ev, 0, sizeof( ev ) );
+    ev.events  = EPOLLIN | EPOLLPRI | ( fWrite ? EPOLLOUT : 0 );
+    ev.data.fd = fd;
+
+    if ( epoll_ctl( np_epfd, op, fd, &ev ) < 0 )
+    {
+	bugf( "Netpoll: epoll_ctl op %d on fd %d: %s",
+	    op, fd, strerror( errno ) );
+	return FALSE;
+    }
+    return TRUE;
+}
+#endif
+
+
+
+void netpoll_init( void )
+{
+#if defined(NETPOLL_EPOLL)
+    /*
+     * Close-on-exec, so a HOTreboot doesn't leak it into the new image;
+     * copyover_recover registers the inherited sockets again anyway.
+     */
+    if ( ( np_epfd = epoll_create1( EPOLL_CLOEXEC ) ) < 0 )
+    {
+	perror( "Netpoll_init: epoll_create1" );
+	exit( 1 );
+    }
+#else
+    FD_ZERO( &np_in_set  );
+    FD_ZERO( &np_out_set );
+    np_maxfd = -1;
+#endif
+    np_grow( 0 );
+    return;
+}
+
+
+
+/*
+ * Start watching fd.  d is the descriptor it belongs to, or NULL for a
+ * listening socket.  Returns FALSE if the socket can't be watched; the
+ * caller should drop the connection.
+ */
+bool netpoll_add( int fd, DESCRIPTOR_DATA *d )
+{
+    if ( fd < 0 )
+	return FALSE;
+
+#if !defined(NETPOLL_EPOLL)
+    if ( fd >= FD_SETSIZE )
+    {
+	bugf( "Netpoll_add: fd %d is past FD_SETSIZE (%d)",
+	    fd, FD_SETSIZE );
+	return FALSE;
+    }
+#endif
+
+    np_grow( fd );
+    if ( np_slot[fd].used )
+    {
+	bugf( "Netpoll_add: fd %d already registered", fd );
+	np_slot[fd].d = d;
+	return TRUE;
+    }
+
+#if defined(NETPOLL_EPOLL)
+    if ( !np_ctl( EPOLL_CTL_ADD, fd, FALSE ) )
+	return FALSE;
+#else
+    FD_SET( fd, &np_in_set );
+    np_maxfd = UMAX( np_maxfd, fd );
+#endif
+
+    np_slot[fd].used  = TRUE;
+    np_slot[fd].write = FALSE;
+    np_slot[fd].d     = d;
+    np_count++;
+    np_grow( fd );
+    return TRUE;
+}
+
+
+
+/*
+ * Stop watching fd.  Call before closing it.
+ */
+void netpoll_del( int fd )
+{
+    if ( fd < 0 || fd >= np_slots || !np_slot[fd].used )
+	return;
+
+#if defined(NETPOLL_EPOLL)
+    epoll_ctl( np_epfd, EPOLL_CTL_DEL, fd, NULL );
+#else
+    FD_CLR( fd, &np_in_set  );
+    FD_CLR( fd, &np_out_set );
+    if ( fd == np_maxfd )
+	while ( np_maxfd >= 0 && !FD_ISSET( np_maxfd, &np_in_set ) )
+	    np_maxfd--;
+#endif
+
+    np_slot[fd].used  = FALSE;
+    np_slot[fd].write = FALSE;
+    np_slot[fd].d     = NULL;
+    np_count--;
+    return;
+}
+
+
+
+/*
+ * Ask (or stop asking) to be told when fd can take more output.  Only
+ * sockets with output queued that the kernel wouldn't take are worth
+ * watching for this; everybody else would be reported every pulse.
+ */
+void netpoll_want_write( int fd, bool fWrite )
+{
+    if ( fd < 0 || fd >= np_slots || !np_slot[fd].used )
+	return;
+    if ( np_slot[fd].write == fWrite )
+	return;
+
+#if defined(NETPOLL_EPOLL)
+    if ( !np_ctl( EPOLL_CTL_MOD, fd, fWrite ) )
+	return;
+#else
+    if ( fWrite )
+	FD_SET( fd, &np_out_set );
+    else
+	FD_CLR( fd, &np_out_set );
+#endif
+
+    np_slot[fd].write = fWrite;
+    return;
+}
+
+
+
+/*
+ * Wait up to msec milliseconds (0 to just poll) and fill netpoll_ready
+ * with the sockets that have something for us.  Returns the number of
+ * edges.
+ */
+int netpoll_wait( int msec )
+{
+    int nready = 0;
+    int n;
+
+#if defined(NETPOLL_EPOLL)
+    int i;
+
+    if ( ( n = epoll_wait( np_epfd, np_events, np_edges, msec ) ) < 0 )
+    {
+	if ( errno == EINTR )
+	    return 0;
+	perror( "Netpoll_wait: epoll_wait" );
+	exit( 1 );
+    }
+
+    for ( i = 0; i < n; i++ )
+    {
+	int fd = np_events[i].data.fd;
+	int events = 0;
+
+	if ( fd < 0 || fd >= np_slots || !np_slot[fd].used )
+	    continue;
+	/* Errors and hangups show up as a failed or empty read. */
+	if ( np_events[i].events & ( EPOLLIN | EPOLLERR | EPOLLHUP ) )
+	    events |= NP_READ;
+	if ( np_events[i].events & EPOLLOUT )
+	    events |= NP_WRITE;
+	if ( np_events[i].events & EPOLLPRI )
+	    events |= NP_EXCEPT;
+
+	netpoll_ready[nready].fd     = fd;
+	netpoll_ready[nready].events = events;
+	netpoll_ready[nready].d      = np_slot[fd].d;
+	nready++;
+    }
+#else
+    fd_set in_set;
+    fd_set out_set;
+    fd_set exc_set;
+    struct timeval timeout;
+    int fd;
+
+    if ( np_maxfd < 0 )
+	return 0;
+
+    in_set  = np_in_set;
+    out_set = np_out_set;
+    exc_set = np_in_set;
+    timeout.tv_sec  = msec / 1000;
+    timeout.tv_usec = ( msec % 1000 ) * 1000;
+
+    if ( ( n = select( np_maxfd + 1, &in_set, &out_set, &exc_set,
+		&timeout ) ) < 0 )
+    {
+	if ( errno == EINTR )
+	    return 0;
+	perror( "Netpoll_wait: select" );
+	exit( 1 );
+    }
+
+    for ( fd = 0; fd <= np_maxfd && nready < np_edges; fd++ )
+    {
+	int events = 0;
+
+	if ( FD_ISSET( fd, &in_set ) )
+	    events |= NP_READ;
+	if ( FD_ISSET( fd, &out_set ) )
+	    events |= NP_WRITE;
+	if ( FD_ISSET( fd, &exc_set ) )
+	    events |= NP_EXCEPT;
+	if ( events == 0 )
+	    continue;
+
+	netpoll_ready[nready].fd     = fd;
+	netpoll_ready[nready].events = events;
+	netpoll_ready[nready].d      = np_slot[fd].d;
+	nready++;
+    }
+#endif
+
+    return nready;
+}
+
+
+
+const char *netpoll_backend( void )
+{
+#if defined(NETPOLL_EPOLL)
+    return "epoll";
+#else
+    return "select";
+#endif
+}
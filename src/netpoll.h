@@ -0,0 +1,70 @@
+/***************************************************************************
+ *  Original Diku Mud copyright (C) 1990, 1991 by Sebastian Hammer,        *
+ *  Michael Seifert, Hans Henrik St{rfeldt, Tom Madsen, and Katja Nyboe.   *
+ *                                                                         *
+ *  Merc Diku Mud improvments copyright (C) 1992, 1993 by Michael          *
+ *  Chastain, Michael Quan, and Mitchell Tse.                              *
+ *                                                                         *
+ *  Ack 2.2 improvements copyright (C) 1994 by Stephen Dooley              *
+ *                                                                         *
+ *  In order to use any part of this Merc Diku Mud, you must comply with   *
+ *  both the original Diku license in 'license.doc' as well the Merc       *
+ *  license in 'license.txt'.  In particular, you may not remove either of *
+ *  these copyright notices.                                               *
+ *                                                                         *
+ *       _/          _/_/_/     _/    _/     _/    ACK! MUD is modified    *
+ *      _/_/        _/          _/  _/       _/    Merc2.0/2.1/2.2 code    *
+ *     _/  _/      _/           _/_/         _/    (c)Stephen Zepp 1998    *
+ *    _/_/_/_/      _/          _/  _/             Version #: 4.3          *
+ *   _/      _/      _/_/_/     _/    _/     _/                            *
+ *                                                                         *
+ *                        http://ackmud.nuc.net/                           *
+ *                        zenithar@ackmud.nuc.net                          *
+ *  Much time and thought has gone into this software and you are          *
+ *  benefitting.  We hope that you share your changes too.  What goes      *
+ *  around, comes around.                                                  *
+ ***************************************************************************/
+
+/*
+ * Descriptor polling.
+ * The game loop used to rebuild three fd_sets from the whole descriptor
+ * list every pulse and hand them to select().  Sockets are now registered
+ * with the poller once, when they are opened, and dropped when they are
+ * closed; each pulse netpoll_wait() hands back only the sockets that are
+ * ready, as a list of edges.  On Linux this sits on epoll, everywhere
+ * else it falls back to select() with fd_sets that are kept up to date
+ * as sockets come and go.
+ */
+
+#define DEC_NETPOLL_H	1
+
+#ifndef DEC_TYPEDEFS_H
+#include "typedefs.h"
+#endif
+
+#if defined(__linux__) && !defined(NO_EPOLL)
+#define NETPOLL_EPOLL
+#endif
+
+/* Readiness bits in a NETPOLL_EDGE, and in d->ioready */
+#define NP_READ		1
+#define NP_WRITE	2
+#define NP_EXCEPT	4
+
+typedef struct netpoll_edge NETPOLL_EDGE;
+
+struct netpoll_edge
+{
+    int                 fd;
+    int                 events;
+    DESCRIPTOR_DATA *   d;      /* NULL for listening sockets */
+};
+
+extern NETPOLL_EDGE *	netpoll_ready;
+
+void		netpoll_init		args( ( void ) );
+bool		netpoll_add		args( ( int fd, DESCRIPTOR_DATA *d ) );
+void		netpoll_del		args( ( int fd ) );
+void		netpoll_want_write	args( ( int fd, bool fWrite ) );
+int		netpoll_wait		args( ( int msec ) );
+const char *	netpoll_backend		args( ( void ) );
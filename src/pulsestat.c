@@ -0,0 +1,210 @@
+/***************************************************************************
+ *  Original Diku Mud copyright (C) 1990, 1991 by Sebastian Hammer,        *
+ *  Michael Seifert, Hans Henrik St{rfeldt, Tom Madsen, and Katja Nyboe.   *
+ *                                                                         *
+ *  Merc Diku Mud improvments copyright (C) 1992, 1993 by Michael          *
+ *  Chastain, Michael Quan, and Mitchell Tse.                              *
+ *                                                                         *
+ *  Ack 2.2 improvements copyright (C) 1994 by Stephen Dooley              *
+ *                                                                         *
+ *  In order to use any part of this Merc Diku Mud, you must comply with   *
+ *  both the original Diku license in 'license.doc' as well the Merc       *
+ *  license in 'license.txt'.  In particular, you may not remove either of *
+ *  these copyright notices.                                               *
+ *                                                                         *
+ *       _/          _/_/_/     _/    _/     _/    ACK! MUD is modified    *
+ *      _/_/        _/          _/  _/       _/    Merc2.0/2.1/2.2 code    *
+ *     _/  _/      _/           _/_/         _/    (c)Stephen Zepp 1998    *
+ *    _/_/_/_/      _/          _/  _/             Version #: 4.3          *
+ *   _/      _/      _/_/_/     _/    _/     _/                            *
+ *                                                                         *
+ *                        http://ackmud.nuc.net/                           *
+ *                        zenithar@ackmud.nuc.net                          *
+ *  Much time and thought has gone into this software and you are          *
+ *  benefitting.  We hope that you share your changes too.  What goes      *
+ *  around, comes around.                                                  *
+ ***************************************************************************/
+
+/*
+ * pulsestat.c: where does the pulse go?
+ *
+ * The game loop and update_handler time their parts with current_usec()
+ * and hand the result to pstat_record().  The last PSTAT_RING samples of
+ * each part are kept in a ring, which is enough for a p50/p99 over the
+ * last minute or so; count, total and worst case are kept since boot
+ * (or the last reset).  'pulsestat' shows it, 'pulsestat log' appends
+ * the same table to PULSESTAT_FILE.
+ */
+
+#include <sys/types.h>
+#include <sys/time.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "ack.h"
+
+
+struct pulse_stat
+{
+    char *	name;
+    long	count;
+    long long	total;
+    long long	max;
+    int		top;			/* next slot in ring */
+    long	ring[PSTAT_RING];	/* usec */
+};
+
+static struct pulse_stat pulse_stat_table[MAX_PSTAT] =
+{
+    { "pulse"    },
+    { "input"    },
+    { "imc"      },
+    { "update"   },
+    { "output"   },
+    { "violence" },
+    { "mobile"   },
+    { "aggr"     },
+    { "char"     },
+    { "obj"      },
+    { "rooms"    },
+    { "area"     },
+    { "message"  },
+    { "auction"  },
+    { "objfun"   },
+    { "gain"     },
+    { "weather"  },
+    { "quest"    }
+};
+
+static time_t pulse_stat_since;
+
+
+
+void pstat_record( int which, long long start )
+{
+    struct pulse_stat *ps;
+    long long used = current_usec( ) - start;
+
+    if ( which < 0 || which >= MAX_PSTAT )
+	return;
+    ps = &pulse_stat_table[which];
+
+    if ( pulse_stat_since == 0 )
+	pulse_stat_since = current_time;
+    if ( used < 0 )
+	used = 0;
+    ps->count++;
+    ps->total += used;
+    if ( used > ps->max )
+	ps->max = used;
+    ps->ring[ps->top] = (long) used;
+    ps->top = ( ps->top + 1 ) % PSTAT_RING;
+    return;
+}
+
+
+
+static int pstat_compare( const void *a, const void *b )
+{
+    long x = *(const long *) a;
+    long y = *(const long *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+/*
+ * One line of the table.  Percentiles come from the ring only.
+ */
+static void pstat_line( struct pulse_stat *ps, char *buf )
+{
+    static long sorted[PSTAT_RING];
+    int n = (int) UMIN( ps->count, PSTAT_RING );
+    long p50 = 0;
+    long p99 = 0;
+
+    if ( n > 0 )
+    {
+	memcpy( sorted, ps->ring, n * sizeof( long ) );
+	qsort( sorted, n, sizeof( long ), pstat_compare );
+	p50 = sorted[( n + 1 ) / 2 - 1];		/* nearest rank */
+	p99 = sorted[( n * 99 + 99 ) / 100 - 1];
+    }
+
+    sprintf( buf, "%-9s %9ld %9.1f %9ld %9ld %9lld %8.2f%%\n\r",
+	ps->name, ps->count,
+	ps->count ? (double) ps->total / ps->count : 0.0,
+	p50, p99, ps->max,
+	pulse_stat_table[PSTAT_PULSE].total
+	    ? 100.0 * ps->total / pulse_stat_table[PSTAT_PULSE].total : 0.0 );
+    return;
+}
+
+static char *pstat_header =
+    "Part          Count   Avg(us)   p50(us)   p99(us)   Max(us)   Of busy\n\r";
+
+
+
+void do_pulsestat( CHAR_DATA *ch, char *argument )
+{
+    char buf[MAX_STRING_LENGTH];
+    char arg[MAX_INPUT_LENGTH];
+    int i;
+
+    one_argument( argument, arg );
+
+    if ( !str_cmp( arg, "reset" ) )
+    {
+	for ( i = 0; i < MAX_PSTAT; i++ )
+	{
+	    pulse_stat_table[i].count = 0;
+	    pulse_stat_table[i].total = 0;
+	    pulse_stat_table[i].max   = 0;
+	    pulse_stat_table[i].top   = 0;
+	}
+	pulse_stat_since = current_time;
+	send_to_char( "Pulse statistics reset.\n\r", ch );
+	return;
+    }
+
+    if ( !str_cmp( arg, "log" ) )
+    {
+	FILE *fp;
+
+	if ( ( fp = fopen( PULSESTAT_FILE, "a" ) ) == NULL )
+	{
+	    send_to_char( "Couldn't open the pulsestat file.\n\r", ch );
+	    return;
+	}
+	fprintf( fp, "%.24s :: pulse statistics since %.24s\n",
+	    ctime( &current_time ), ctime( &pulse_stat_since ) );
+	fprintf( fp, "%.*s\n", (int) strlen( pstat_header ) - 2, pstat_header );
+	for ( i = 0; i < MAX_PSTAT; i++ )
+	{
+	    pstat_line( &pulse_stat_table[i], buf );
+	    fprintf( fp, "%.*s\n", (int) strlen( buf ) - 2, buf );
+	}
+	fprintf( fp, "\n" );
+	fclose( fp );
+	send_to_char( "Pulse statistics written to " PULSESTAT_FILE ".\n\r", ch );
+	return;
+    }
+
+    if ( arg[0] != '\0' )
+    {
+	send_to_char( "Syntax: pulsestat [reset|log]\n\r", ch );
+	return;
+    }
+
+    sprintf( buf, "Pulse statistics since %.24s, budget %dus a pulse.\n\r\n\r",
+	ctime( &pulse_stat_since ), PULSE_USEC );
+    send_to_char( buf, ch );
+    send_to_char( pstat_header, ch );
+    for ( i = 0; i < MAX_PSTAT; i++ )
+    {
+	pstat_line( &pulse_stat_table[i], buf );
+	send_to_char( buf, ch );
+    }
+    return;
+}
@@ -0,0 +1,467 @@
+/***************************************************************************
+ *  Original Diku Mud copyright (C) 1990, 1991 by Sebastian Hammer,        *
+ *  Michael Seifert, Hans Henrik St{rfeldt, Tom Madsen, and Katja Nyboe.   *
+ *                                                                         *
+ *  Merc Diku Mud improvments copyright (C) 1992, 1993 by Michael          *
+ *  Chastain, Michael Quan, and Mitchell Tse.                              *
+ *                                                                         *
+ *  Ack 2.2 improvements copyright (C) 1994 by Stephen Dooley              *
+ *                                                                         *
+ *  In order to use any part of this Merc Diku Mud, you must comply with   *
+ *  both the original Diku license in 'license.doc' as well the Merc       *
+ *  license in 'license.txt'.  In particular, you may not remove either of *
+ *  these copyright notices.                                               *
+ *                                                                         *
+ *       _/          _/_/_/     _/    _/     _/    ACK! MUD is modified    *
+ *      _/_/        _/          _/  _/       _/    Merc2.0/2.1/2.2 code    *
+ *     _/  _/      _/           _/_/         _/    (c)Stephen Zepp 1998    *
+ *    _/_/_/_/      _/          _/  _/             Version #: 4.3          *
+ *   _/      _/      _/_/_/     _/    _/     _/                            *
+ *                                                                         *
+ *                        http://ackmud.nuc.net/                           *
+ *                        zenithar@ackmud.nuc.net                          *
+ *  Much time and thought has gone into this software and you are          *
+ *  benefitting.  We hope that you share your changes too.  What goes      *
+ *  around, comes around.                                                  *
+ ***************************************************************************/
+
+/*
+ * resolve.c: reverse DNS for new connections, off the game loop.
+ *
+ * Looking a site up used to be done with gethostbyaddr() right in
+ * new_descriptor, which froze the whole mud whenever a nameserver was
+ * slow; it ended up commented out and we've been logging bare IPs since.
+ * Lookups now go to a resolver thread.  The connection sits in
+ * CON_RESOLVING until the name comes back (or RESOLVE_WAIT runs out),
+ * then host_resolved() in comm.c does the site ban check and lets it log
+ * in.  Answers are kept in a small LRU cache keyed by address so people
+ * reconnecting don't wait twice.
+ *
+ * Only the game thread touches the cache and descriptors.  The resolver
+ * thread only sees DNS_JOBs, handed across under resolve_lock.
+ */
+
+#include <sys/types.h>
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+#include <netdb.h>
+#include <pthread.h>
+#include "ack.h"
+
+
+#define RESOLVE_CACHE_MAX	512	/* entries before we drop the LRU one */
+#define RESOLVE_HASH		256
+#define RESOLVE_TTL		( 60 * 60 )	/* good answers, seconds    */
+#define RESOLVE_NEG_TTL		( 5 * 60 )	/* failed lookups, seconds  */
+#define RESOLVE_WAIT		10	/* how long a login waits, seconds  */
+
+typedef struct dns_entry DNS_ENTRY;
+typedef struct dns_job DNS_JOB;
+
+struct dns_entry
+{
+    bool		is_free;	/* for LINK/UNLINK checks      */
+    DNS_ENTRY *		next_hash;
+    DNS_ENTRY *		next;		/* LRU list, most recent first */
+    DNS_ENTRY *		prev;
+    struct in_addr	addr;
+    char		ip[16];
+    char *		host;		/* NULL if the lookup failed   */
+    time_t		expires;
+    int			hits;
+    bool		pending;	/* a job is out for it now     */
+};
+
+struct dns_job
+{
+    DNS_JOB *		next;
+    struct in_addr	addr;
+    bool		found;
+    char		host[NI_MAXHOST];
+};
+
+static DNS_ENTRY *	dns_hash[RESOLVE_HASH];
+static DNS_ENTRY *	first_dns	= NULL;
+static DNS_ENTRY *	last_dns	= NULL;
+static int		dns_count	= 0;
+static int		dns_waiting	= 0;	/* descriptors in CON_RESOLVING */
+static long		dns_lookups	= 0;
+static long		dns_cache_hits	= 0;
+
+static pthread_mutex_t	resolve_lock	= PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t	resolve_cond	= PTHREAD_COND_INITIALIZER;
+static DNS_JOB *	first_job	= NULL;	/* waiting for the thread */
+static DNS_JOB *	last_job	= NULL;
+static DNS_JOB *	first_done	= NULL;	/* answered, for us       */
+static DNS_JOB *	last_done	= NULL;
+static bool		resolver_up	= FALSE;
+
+
+
+static int dns_hash_key( struct in_addr addr )
+{
+    unsigned long a = ntohl( addr.s_addr );
+
+    return ( a ^ ( a >> 8 ) ^ ( a >> 16 ) ) % RESOLVE_HASH;
+}
+
+static DNS_ENTRY *dns_find( struct in_addr addr )
+{
+    DNS_ENTRY *dns;
+
+    for ( dns = dns_hash[dns_hash_key( addr )]; dns; dns = dns->next_hash )
+	if ( dns->addr.s_addr == addr.s_addr )
+	    return dns;
+    return NULL;
+}
+
+static void dns_touch( DNS_ENTRY *dns )
+{
+    if ( dns == first_dns )
+	return;
+    UNLINK( dns, first_dns, last_dns, next, prev );
+    TOPLINK( dns, first_dns, last_dns, next, prev );
+}
+
+static void dns_free( DNS_ENTRY *dns )
+{
+    DNS_ENTRY **pdns;
+
+    for ( pdns = &dns_hash[dns_hash_key( dns->addr )]; *pdns;
+	  pdns = &(*pdns)->next_hash )
+	if ( *pdns == dns )
+	{
+	    *pdns = dns->next_hash;
+	    break;
+	}
+    UNLINK( dns, first_dns, last_dns, next, prev );
+    if ( dns->host )
+	free_string( dns->host );
+    dispose( dns, sizeof( DNS_ENTRY ) );
+    dns_count--;
+}
+
+static DNS_ENTRY *dns_new( struct in_addr addr, const char *ip )
+{
+    DNS_ENTRY *dns;
+    int key;
+
+    /* Full?  Drop the least recently used one that isn't being looked up. */
+    if ( dns_count >= RESOLVE_CACHE_MAX )
+    {
+	DNS_ENTRY *old;
+
+	for ( old = last_dns; old && old->pending; old = old->prev )
+	    ;
+	if ( old )
+	    dns_free( old );
+    }
+
+    dns = getmem( sizeof( DNS_ENTRY ) );
+    dns->addr = addr;
+    strncpy( dns->ip, ip, sizeof( dns->ip ) - 1 );
+    key = dns_hash_key( addr );
+    dns->next_hash = dns_hash[key];
+    dns_hash[key] = dns;
+    TOPLINK( dns, first_dns, last_dns, next, prev );
+    dns_count++;
+    return dns;
+}
+
+
+
+/*
+ * The resolver thread.  Takes a job, looks it up with the lock dropped,
+ * hands it back.  getnameinfo is thread safe where gethostbyaddr isn't.
+ */
+static void *resolver_thread( void *arg )
+{
+    for ( ; ; )
+    {
+	struct sockaddr_in sa;
+	DNS_JOB *job;
+
+	pthread_mutex_lock( &resolve_lock );
+	while ( first_job == NULL )
+	    pthread_cond_wait( &resolve_cond, &resolve_lock );
+	job = first_job;
+	if ( ( first_job = job->next ) == NULL )
+	    last_job = NULL;
+	pthread_mutex_unlock( &resolve_lock );
+
+	memset( &sa, 0, sizeof( sa ) );
+	sa.sin_family = AF_INET;
+	sa.sin_addr   = job->addr;
+	job->found = ( getnameinfo( (struct sockaddr *) &sa, sizeof( sa ),
+			    job->host, sizeof( job->host ), NULL, 0,
+			    NI_NAMEREQD ) == 0 );
+
+	pthread_mutex_lock( &resolve_lock );
+	job->next = NULL;
+	if ( last_done )
+	    last_done->next = job;
+	else
+	    first_done = job;
+	last_done = job;
+	pthread_mutex_unlock( &resolve_lock );
+    }
+    return NULL;
+}
+
+
+
+void resolve_init( void )
+{
+    pthread_t thread;
+    sigset_t all;
+    sigset_t old;
+
+    /*
+     * The thread must never take our signals (the alarm watchdog in
+     * particular), so start it with everything blocked.
+     */
+    sigfillset( &all );
+    pthread_sigmask( SIG_SETMASK, &all, &old );
+    if ( pthread_create( &thread, NULL, resolver_thread, NULL ) != 0 )
+    {
+	log_string( "Resolve_init: can't start resolver thread, using IPs." );
+	resolver_up = FALSE;
+    }
+    else
+    {
+	pthread_detach( thread );
+	resolver_up = TRUE;
+    }
+    pthread_sigmask( SIG_SETMASK, &old, NULL );
+    return;
+}
+
+
+
+/*
+ * Called from new_descriptor.  If the cache knows the answer the host is
+ * filled in now and we return TRUE.  Otherwise a lookup is started and
+ * the descriptor is left in CON_RESOLVING for resolve_update to finish.
+ */
+bool resolve_host( DESCRIPTOR_DATA *d )
+{
+    DNS_ENTRY *dns;
+    struct in_addr addr;
+
+    if ( !inet_aton( d->ip, &addr ) )
+	return TRUE;
+
+    if ( ( dns = dns_find( addr ) ) != NULL
+    &&   !dns->pending && dns->expires <= current_time )
+    {
+	dns_free( dns );
+	dns = NULL;
+    }
+
+    if ( dns != NULL && !dns->pending )
+    {
+	dns->hits++;
+	dns_cache_hits++;
+	dns_touch( dns );
+	if ( dns->host != NULL )
+	{
+	    free_string( d->host );
+	    d->host = str_dup( dns->host );
+	}
+	return TRUE;
+    }
+
+    if ( !resolver_up )
+	return TRUE;
+
+    if ( dns == NULL )
+    {
+	DNS_JOB *job;
+
+	dns = dns_new( addr, d->ip );
+	dns->pending = TRUE;
+	dns_lookups++;
+
+	job = getmem( sizeof( DNS_JOB ) );
+	job->addr = addr;
+	pthread_mutex_lock( &resolve_lock );
+	if ( last_job )
+	    last_job->next = job;
+	else
+	    first_job = job;
+	last_job = job;
+	pthread_cond_signal( &resolve_cond );
+	pthread_mutex_unlock( &resolve_lock );
+    }
+    else
+	dns_touch( dns );
+
+    d->connected = CON_RESOLVING;
+    d->resolve_wait = current_time + RESOLVE_WAIT;
+    dns_waiting++;
+    return FALSE;
+}
+
+
+
+/*
+ * Let a descriptor in CON_RESOLVING go on with whatever we know.
+ */
+static void resolve_release( DESCRIPTOR_DATA *d, DNS_ENTRY *dns )
+{
+    if ( dns != NULL && dns->host != NULL )
+    {
+	free_string( d->host );
+	d->host = str_dup( dns->host );
+    }
+    dns_waiting--;
+    host_resolved( d );
+    return;
+}
+
+
+
+/*
+ * Once a pulse from the game loop: collect answers from the thread, and
+ * let go of anybody who has waited too long.
+ */
+void resolve_update( void )
+{
+    DESCRIPTOR_DATA *d;
+    DESCRIPTOR_DATA *d_next;
+    DNS_JOB *done;
+    DNS_JOB *job_next;
+
+    if ( !resolver_up )
+	return;
+
+    pthread_mutex_lock( &resolve_lock );
+    done = first_done;
+    first_done = last_done = NULL;
+    pthread_mutex_unlock( &resolve_lock );
+
+    for ( ; done != NULL; done = job_next )
+    {
+	DNS_ENTRY *dns;
+
+	job_next = done->next;
+	if ( ( dns = dns_find( done->addr ) ) == NULL )
+	    dns = dns_new( done->addr, inet_ntoa( done->addr ) );
+
+	dns->pending = FALSE;
+	if ( dns->host )
+	    free_string( dns->host );
+	dns->host    = done->found ? str_dup( done->host ) : NULL;
+	dns->expires = current_time
+		     + ( done->found ? RESOLVE_TTL : RESOLVE_NEG_TTL );
+
+	for ( d = first_desc; d != NULL && dns_waiting > 0; d = d_next )
+	{
+	    d_next = d->next;
+	    if ( d->connected == CON_RESOLVING
+	    &&   !strcmp( d->ip, dns->ip ) )
+		resolve_release( d, dns );
+	}
+	dispose( done, sizeof( DNS_JOB ) );
+    }
+
+    /* Slow nameserver?  Don't keep them staring at the greeting. */
+    for ( d = first_desc; d != NULL && dns_waiting > 0; d = d_next )
+    {
+	d_next = d->next;
+	if ( d->connected == CON_RESOLVING && d->resolve_wait <= current_time )
+	    resolve_release( d, NULL );
+    }
+    return;
+}
+
+
+
+/*
+ * close_socket tells us when a descriptor goes away mid-lookup.
+ */
+void resolve_forget( DESCRIPTOR_DATA *d )
+{
+    if ( d->connected == CON_RESOLVING )
+	dns_waiting--;
+    return;
+}
+
+
+/*
+ * For do_scheck: the cache holds a str_dup of every host it knows.
+ */
+void resolve_markstrings( void (*touch)( char *str ) )
+{
+    DNS_ENTRY *dns;
+
+    for ( dns = first_dns; dns != NULL; dns = dns->next )
+	touch( dns->host );
+    return;
+}
+
+
+
+void do_dnscache( CHAR_DATA *ch, char *argument )
+{
+    char buf[MAX_STRING_LENGTH];
+    char arg[MAX_INPUT_LENGTH];
+    DNS_ENTRY *dns;
+
+    one_argument( argument, arg );
+
+    if ( !str_cmp( arg, "flush" ) )
+    {
+	DNS_ENTRY *dns_next;
+
+	for ( dns = first_dns; dns != NULL; dns = dns_next )
+	{
+	    dns_next = dns->next;
+	    if ( !dns->pending )
+		dns_free( dns );
+	}
+	send_to_char( "DNS cache flushed.\n\r", ch );
+	return;
+    }
+
+    if ( arg[0] != '\0' )
+    {
+	send_to_char( "Syntax: dnscache [flush]\n\r", ch );
+	return;
+    }
+
+    sprintf( buf, "Resolver: %s.  %d cached (max %d), %d waiting.\n\r",
+	resolver_up ? "running" : "not running",
+	dns_count, RESOLVE_CACHE_MAX, dns_waiting );
+    send_to_char( buf, ch );
+    sprintf( buf, "%ld lookups, %ld cache hits.\n\r\n\r",
+	dns_lookups, dns_cache_hits );
+    send_to_char( buf, ch );
+
+    send_to_char( "Address          Expires  Hits  Host\n\r", ch );
+    for ( dns = first_dns; dns != NULL; dns = dns->next )
+    {
+	char expires[32];
+
+	if ( dns->pending )
+	    strcpy( expires, "pending" );
+	else if ( dns->expires <= current_time )
+	    strcpy( expires, "expired" );
+	else
+	    sprintf( expires, "%ldm", (long)( dns->expires - current_time ) / 60 );
+
+	sprintf( buf, "%-16s %7s %5d  %s\n\r",
+	    dns->ip, expires, dns->hits,
+	    dns->host ? dns->host : dns->pending ? "" : "(no name)" );
+	send_to_char( buf, ch );
+    }
+    return;
+}
@@ -97,7 +97,7 @@ static void touch(char *str)
   if (!str)
     return;
 
-  if (str < string_space || str > top_string)
+  if (!ssm_owns(str))
     return;			/* not in string space */
 
   p = (BufEntry *) (str - HEADER_SIZE);
@@ -110,7 +110,7 @@ static void clear(void)
 
   BufEntry *p;
 
-  for (p = ssm_buf_head; p; p = p->next)
+  for (p = ssm_walk(NULL); p; p = ssm_walk(p))
     p->ref = 0;
 }
 
@@ -127,7 +127,7 @@ static long dump(void)
   fclose(fpReserve);
   dumpf = fopen("../reports/leaks.dmp", "w");
 
-  for (p = ssm_buf_head; p; p = p->next)
+  for (p = ssm_walk(NULL); p; p = ssm_walk(p))
   {
     if (p->usage > 0 && p->usage != p->ref)
     {
@@ -675,6 +675,35 @@ void do_scheck(CHAR_DATA * ch, char *argument)
 {
   char buf[MAX_STRING_LENGTH];
   extern bool disable_timer_abort;
+  extern bool worn_debug;
+
+  if (!str_cmp(argument, "worn"))
+  {
+    /* equipment slots: check them all now, and every get_eq_char */
+    worn_debug = !worn_debug;
+    sprintf(buf, "%d equipment slots out; checking get_eq_char is now %s.\n\r",
+	    worn_check(), worn_debug ? "ON" : "OFF");
+    send_to_char(buf, ch);
+    return;
+  }
+
+  if (!str_cmp(argument, "names"))
+  {
+    /* the name index behind get_char_world */
+    sprintf(buf, "%d name words can't be found.\n\r", name_check());
+    send_to_char(buf, ch);
+    return;
+  }
+
+  if (!str_cmp(argument, "rooms"))
+  {
+    /* the player and aggressor lists behind aggr_update */
+    sprintf(buf, "%d characters or rooms out in the aggression lists.\n\r",
+	    room_kind_check());
+    send_to_char(buf, ch);
+    return;
+  }
+
   disable_timer_abort = TRUE;
   clear();
 
@@ -708,8 +737,16 @@ void do_scheck(CHAR_DATA * ch, char *argument)
   icec_markstrings(touch);
 #endif
 
+  resolve_markstrings(touch);
+  help_markstrings(touch);
+
   sprintf(buf, "%ld leaks dumped to leaks.dmp\n\r",
 	  dump());
   send_to_char(buf, ch);
+
+  /* and the per-site accounting had better agree with the heap */
+  sprintf(buf, "%d string sites disagree with memstat.\n\r",
+	  mem_check_shared());
+  send_to_char(buf, ch);
   disable_timer_abort = FALSE;
 }
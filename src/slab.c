@@ -0,0 +1,213 @@
+/***************************************************************************
+ *  Original Diku Mud copyright (C) 1990, 1991 by Sebastian Hammer,        *
+ *  Michael Seifert, Hans Henrik St{rfeldt, Tom Madsen, and Katja Nyboe.   *
+ *                                                                         *
+ *  Merc Diku Mud improvments copyright (C) 1992, 1993 by Michael          *
+ *  Chastain, Michael Quan, and Mitchell Tse.                              *
+ *                                                                         *
+ *  Ack 2.2 improvements copyright (C) 1994 by Stephen Dooley              *
+ *                                                                         *
+ *  In order to use any part of this Merc Diku Mud, you must comply with   *
+ *  both the original Diku license in 'license.doc' as well the Merc       *
+ *  license in 'license.txt'.  In particular, you may not remove either of *
+ *  these copyright notices.                                               *
+ *                                                                         *
+ *       _/          _/_/_/     _/    _/     _/    ACK! MUD is modified    *
+ *      _/_/        _/          _/  _/       _/    Merc2.0/2.1/2.2 code    *
+ *     _/  _/      _/           _/_/         _/    (c)Stephen Zepp 1998    *
+ *    _/_/_/_/      _/          _/  _/             Version #: 4.3          *
+ *   _/      _/      _/_/_/     _/    _/     _/                            *
+ *                                                                         *
+ *                        http://ackmud.nuc.net/                           *
+ *                        zenithar@ackmud.nuc.net                          *
+ *  Much time and thought has gone into this software and you are          *
+ *  benefitting.  We hope that you share your changes too.  What goes      *
+ *  around, comes around.                                                  *
+ ***************************************************************************/
+
+/*
+ * slab.c: where freelist objects come from.
+ *
+ * GET_FREE used to getmem() a new object whenever its freelist was
+ * empty, one at a time, and nothing on a freelist was ever given back.
+ * Now each freelist has a SLAB_TYPE, and new objects are carved in
+ * order out of slabs of about SLAB_SIZE bytes, so things made together
+ * sit together.  Every object has a pointer to its slab just in front
+ * of it, which lets GET_FREE and PUT_FREE keep count of how many of a
+ * slab's objects are live, and PUT_FREE tells the type where its
+ * freelist link is so that slab_trim can walk the list.  The memstat
+ * site that took the object off the freelist is kept there too.
+ *
+ * A slab with nothing live is given back by slab_trim once it has been
+ * that way for SLAB_HOLD seconds.  Freed objects stay readable (with
+ * is_free set) for that long because stale pointers to them do get
+ * looked at.
+ */
+
+#include <sys/types.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "ack.h"
+
+#define SLAB_ALIGN(n)	( ( (n) + 7 ) & ~7 )
+#define SLAB_HEAD	SLAB_ALIGN( sizeof( struct slab_head ) )
+#define HEAD_OF(obj)	( (struct slab_head *) ( (char *) (obj) - SLAB_HEAD ) )
+#define SLAB_OF(obj)	( HEAD_OF( obj )->slab )
+
+struct slab_head
+{
+    SLAB *		slab;
+    int			site;		/* see memstat.c */
+};
+
+struct slab
+{
+    bool		is_free;
+    SLAB *		next;
+    SLAB *		prev;
+    SLAB_TYPE *		type;
+    int			carved;		/* objects handed out so far */
+    int			used;		/* of those, how many are live */
+    time_t		empty_since;
+    bool		doomed;
+};
+
+static SLAB_TYPE *	first_slab_type;
+
+static int slab_bytes( SLAB_TYPE *type )
+{
+    return SLAB_ALIGN( sizeof( SLAB ) ) + type->per_slab * type->stride;
+}
+
+/*
+ * A new object of type, for GET_FREE when the freelist is empty.
+ */
+void *slab_alloc( SLAB_TYPE *type, int size, const char *caller )
+{
+    SLAB *slab;
+    char *obj;
+
+    if ( type->size == 0 )
+    {
+	type->size	= size;
+	type->stride	= SLAB_HEAD + SLAB_ALIGN( size );
+	type->per_slab	= UMAX( SLAB_MIN_OBJS,
+	    ( SLAB_SIZE - (int) SLAB_ALIGN( sizeof( SLAB ) ) ) / type->stride );
+	type->next	= first_slab_type;
+	first_slab_type	= type;
+    }
+
+    if ( ( slab = type->current ) == NULL || slab->carved >= type->per_slab )
+    {
+	slab		= getmem( slab_bytes( type ) );
+	slab->type	= type;
+	LINK( slab, type->first_slab, type->last_slab, next, prev );
+	type->current	= slab;
+	type->slabs++;
+    }
+
+    obj = (char *) slab + SLAB_ALIGN( sizeof( SLAB ) )
+	+ slab->carved++ * type->stride + SLAB_HEAD;
+    HEAD_OF( obj )->slab = slab;
+    HEAD_OF( obj )->site = mem_site( caller, MEM_FREELIST );
+    mem_count( HEAD_OF( obj )->site, type->size );
+    slab->used++;
+    type->live++;
+    return obj;
+}
+
+/*
+ * Keep count as objects come off and go on their freelist.
+ */
+void slab_get( void *obj, const char *caller )
+{
+    SLAB *slab = SLAB_OF( obj );
+
+    HEAD_OF( obj )->site = mem_site( caller, MEM_FREELIST );
+    mem_count( HEAD_OF( obj )->site, slab->type->size );
+    slab->used++;
+    slab->type->live++;
+    slab->type->free--;
+    return;
+}
+
+void slab_put( void *obj, int next_offset )
+{
+    SLAB *slab = SLAB_OF( obj );
+
+    slab->type->next_offset = next_offset;
+    mem_count( HEAD_OF( obj )->site, -(long) slab->type->size );
+    slab->type->live--;
+    slab->type->free++;
+    if ( --slab->used == 0 )
+	slab->empty_since = current_time;
+    return;
+}
+
+/*
+ * Give back type's slabs that have been empty for SLAB_HOLD, taking
+ * their objects off the freelist first.  Use SLAB_TRIM.
+ */
+void slab_trim( SLAB_TYPE *type, void **freelist )
+{
+    int next_offset = type->next_offset;
+    SLAB *slab;
+    SLAB *slab_next;
+    void **link;
+    int doomed = 0;
+
+    for ( slab = type->first_slab; slab != NULL; slab = slab->next )
+	if ( slab->used == 0
+	&&   slab != type->current
+	&&   current_time - slab->empty_since >= SLAB_HOLD )
+	{
+	    slab->doomed = TRUE;
+	    doomed++;
+	}
+
+    if ( doomed == 0 )
+	return;
+
+    for ( link = freelist; *link != NULL; )
+	if ( SLAB_OF( *link )->doomed )
+	{
+	    *link = *(void **) ( (char *) *link + next_offset );
+	    type->free--;
+	}
+	else
+	    link = (void **) ( (char *) *link + next_offset );
+
+    for ( slab = type->first_slab; slab != NULL; slab = slab_next )
+    {
+	slab_next = slab->next;
+	if ( !slab->doomed )
+	    continue;
+	UNLINK( slab, type->first_slab, type->last_slab, next, prev );
+	dispose( slab, slab_bytes( type ) );
+	type->slabs--;
+    }
+    return;
+}
+
+/*
+ * Occupancy, for 'memory'.
+ */
+void slab_report( CHAR_DATA *ch )
+{
+    char buf[MAX_STRING_LENGTH];
+    SLAB_TYPE *type;
+    long bytes = 0;
+
+    send_to_char( "Slabs:  Type              Size   Live   Free  Slabs\n\r", ch );
+    for ( type = first_slab_type; type != NULL; type = type->next )
+    {
+	sprintf( buf, "        %-16s %5d %6d %6d %6d\n\r",
+	    type->name, type->size, type->live, type->free, type->slabs );
+	send_to_char( buf, ch );
+	bytes += (long) type->slabs * slab_bytes( type );
+    }
+    sprintf( buf, "        %ld bytes in slabs.\n\r", bytes );
+    send_to_char( buf, ch );
+    return;
+}
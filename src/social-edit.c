@@ -209,6 +209,7 @@ void do_sedit (CHAR_DATA *ch, char *argument)
 		social_table = new_table;
 		
 		maxSocial--; /* Important :() */
+		build_social_trie ();
 		
 		send_to_char ("That social is history now.\n\r",ch);
 				
@@ -248,6 +249,7 @@ void do_sedit (CHAR_DATA *ch, char *argument)
 		social_table[maxSocial-1].others_auto = str_dup ("");
 		
 		social_table[maxSocial].name = str_dup (""); /* 'terminating' empty string */
+		build_social_trie ();
 		
 		send_to_char ("New social added.\n\r",ch);
 			
@@ -272,7 +272,7 @@ bool spec_breath_gas( CHAR_DATA *ch )
     if ( ch->position != POS_FIGHTING )
 	return FALSE;
 
-    if ( ( sn = skill_lookup( "gas breath" ) ) < 0 )
+    if ( ( sn = gsn_gas_breath ) < 0 )
 	return FALSE;
     (*skill_table[sn].spell_fun) ( sn, ch->level, ch, NULL, NULL );
     return TRUE;
@@ -303,9 +303,9 @@ bool spec_cast_adept( CHAR_DATA *ch )
     if (  ch->in_room != NULL )
     {
       if ( !IS_SET( ch->in_room->affected_by, ROOM_BV_HEAL_REGEN ) )
-        spell_healing_light( skill_lookup( "healing light" ), 79, ch, NULL, NULL );
+        spell_healing_light( gsn_healing_light, 79, ch, NULL, NULL );
       if ( !IS_SET( ch->in_room->affected_by, ROOM_BV_MANA_REGEN ) )
-        spell_mana_flare( skill_lookup( "mana flare" ), 79, ch, NULL, NULL );
+        spell_mana_flare( gsn_mana_flare, 79, ch, NULL, NULL );
     }
 
     for ( victim = ch->in_room->first_person; victim != NULL;
@@ -324,29 +324,29 @@ bool spec_cast_adept( CHAR_DATA *ch )
     {
     case 0:
 	act( "$n utters the word 'tehctah'.", ch, NULL, NULL, TO_ROOM );
-	spell_armor( skill_lookup( "armor" ), cl, ch, victim, NULL );
+	spell_armor( gsn_armor, cl, ch, victim, NULL );
 	return TRUE;
 
     case 1:
 	act( "$n utters the word 'nhak'.", ch, NULL, NULL, TO_ROOM );
-	spell_bless( skill_lookup( "bless" ), cl, ch, victim, NULL );
+	spell_bless( gsn_bless, cl, ch, victim, NULL );
 	return TRUE;
 
     case 2:
 	act( "$n utters the word 'yeruf'.", ch, NULL, NULL, TO_ROOM );
-	spell_cure_blindness( skill_lookup( "cure blindness" ),
+	spell_cure_blindness( gsn_cure_blindness,
 	    cl, ch, victim, NULL );
 	return TRUE;
 
     case 3:
 	act( "$n utters the word 'garf'.", ch, NULL, NULL, TO_ROOM );
-	spell_cure_light( skill_lookup( "cure light" ),
+	spell_cure_light( gsn_cure_light,
 	    cl, ch, victim, NULL );
 	return TRUE;
 
     case 4:
 	act( "$n utters the words 'rozar'.", ch, NULL, NULL, TO_ROOM );
-	spell_cure_poison( skill_lookup( "cure poison" ),
+	spell_cure_poison( gsn_cure_poison,
 	    cl, ch, victim, NULL );
 	return TRUE;
 
@@ -370,7 +370,7 @@ bool spec_cast_adept( CHAR_DATA *ch )
 	 sprintf(buffer,"$n utters the words '%i days to Christmas!'.",days);
 	 
 	 act( buffer, ch, NULL, NULL, TO_ROOM );
-	 spell_refresh( skill_lookup( "refresh" ), ch->level, ch, victim, NULL );
+	 spell_refresh( gsn_refresh, ch->level, ch, victim, NULL );
 	 return TRUE;
 	}
 
@@ -981,7 +981,7 @@ bool spec_cast_cadaver( CHAR_DATA *ch )
     if ( !IS_AFFECTED( victim, AFF_DETECT_INVIS ) )
     {
         act( "$n utters the word 'Sight'.", ch, NULL, NULL, TO_ROOM );
-	  spell_detect_invis( skill_lookup( "detect invis" ), 0, ch, victim, NULL );
+	  spell_detect_invis( gsn_detect_invis, 0, ch, victim, NULL );
 	  return TRUE;
     }
   }
@@ -1411,8 +1411,8 @@ bool spec_sage( CHAR_DATA *ch )
         break;
     case 'C':
         do_say( ch, "You must be hungry.  Share some food with me.");
-        spell_produce_food( skill_lookup( "produce food" ), 1, ch, NULL, NULL );
-        spell_produce_food( skill_lookup( "produce food" ), 1, ch, NULL, NULL );
+        spell_produce_food( gsn_produce_food, 1, ch, NULL, NULL );
+        spell_produce_food( gsn_produce_food, 1, ch, NULL, NULL );
         break;
     case 'U':
         do_get( ch, "bundle" );
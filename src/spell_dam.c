@@ -789,7 +789,7 @@ bool sp_damage( OBJ_DATA * obj, CHAR_DATA *ch, CHAR_DATA *victim, int dam, int t
           ( get_curr_int( ch ) * ch->pcdata->learned[gsn_thaumatergy] /2500 );
       }     
     }       
-    if ( is_affected( ch, skill_lookup( "mystical focus" ) ) )
+    if ( is_affected( ch, gsn_mystical_focus ) )
     {
       dam_modifier += .5;
     }
@@ -53,6 +53,7 @@
 
 #include <sys/types.h>
 #include <ctype.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -65,125 +66,470 @@
 
 #include "ssm.h"
 
-TempHash **temp_string_hash;
-
 /* These are the original Merc vars in db.c */
 char str_empty[1];
-char *string_space;
-char *top_string;
 long nAllocString;
 long sAllocString;
 long nOverFlowString;
 long sOverFlowString;
 long hwOverFlow;
-int numFree;
+long nInternString;
 bool Full;
-extern bool fBootDb;
 
 /*
- * ssm_buf_head points to start of shared space,
- * ssm_buf_free points to next free block
+ * ssm_buf_head points to start of shared space
  */
-BufEntry *ssm_buf_head, *ssm_buf_free;
+BufEntry *ssm_buf_head;
 
-long MAX_STRING = MAX_CHUNKS * CHUNK_SIZE;
+long MAX_STRING;
 int HEADER_SIZE;
 long tot = 0;
 
-void init_string_space()
+static BufEntry *ssm_bin[SSM_BINS];	/* free chunks by size */
+static BufEntry **ssm_hash;		/* in-use chunks by content */
+
+typedef struct SA Arena;
+
+struct SA
 {
-  BufEntry *walk;
+  char *base;				/* NULL once given back */
+  char *end;
+  BufEntry *fence;
+};
+
+static Arena ssm_arena[SSM_MAX_ARENAS];
+static int ssm_arena_top;		/* slots used, given back or not */
+int ssm_arenas;
+static BufEntry *ssm_fence;		/* at the end of the last arena */
+
+/*
+ * A granule keeps its slot once it has had an arena, so that lookups
+ * for the granules after it still probe past.
+ */
+static struct
+{
+  size_t granule;
+  bool used;
+  short arena[2];			/* index + 1, 0 for none */
+} ssm_registry[SSM_REGISTRY];
+
+/* The background sweep, see ssm_sweep() */
+static BufEntry *sweep_at;		/* next chunk, NULL between passes */
+static int sweep_arena;			/* the arena sweep_at is in */
+static bool sweep_empty;		/* nothing in use there so far */
+static long sweep_bytes;		/* covered by this pass */
+static time_t sweep_last;		/* when the last pass finished */
+long ssm_sweeps;
+long ssm_released;
+long ssm_reclaimed;
+
+#define REGISTRY_SLOT(g)  ( (int) ( ( (g) * 2654435761U ) & ( SSM_REGISTRY - 1 ) ) )
+
+/* The biggest a chunk can be, so its size fits a uintType */
+#define SSM_MAX_SIZE	( CHUNK_SIZE - HEADER_SIZE )
+
+static int bin_of(int size)
+{
+  int bin;
+  int over;
+
+  if (size <= SSM_SMALL)
+    return (size - 1) / 8;
+
+  for (bin = SSM_SMALL_BINS, over = (size - 1) / (SSM_SMALL * 2);
+       over; over >>= 1)
+    bin++;
+  return bin;
+}
+
+static void bin_link(BufEntry * p)
+{
+  BufEntry **head = &ssm_bin[bin_of(p->size)];
+
+  p->usage = 0;
+  p->next = *head;
+  BIN_PREV(p) = NULL;
+  if (*head)
+    BIN_PREV(*head) = p;
+  *head = p;
+}
+
+static void bin_unlink(BufEntry * p)
+{
+  if (BIN_PREV(p))
+    BIN_PREV(p)->next = p->next;
+  else
+    ssm_bin[bin_of(p->size)] = p->next;
+  if (p->next)
+    BIN_PREV(p->next) = BIN_PREV(p);
+}
+
+/* The chunks either side of p; the one after may be a fence */
+static BufEntry *ssm_after(BufEntry * p)
+{
+  return (BufEntry *) ((char *) p + HEADER_SIZE + p->size);
+}
+
+static BufEntry *ssm_before(BufEntry * p)
+{
+  return p->prev ? (BufEntry *) ((char *) p - HEADER_SIZE - p->prev) : NULL;
+}
+
+/*
+ * Walk every chunk in address order, starting with ssm_walk(NULL).
+ */
+BufEntry *ssm_walk(BufEntry * p)
+{
+  p = p ? ssm_after(p) : ssm_buf_head;
+  while (p && p->size == 0)
+    p = p->next;
+  return p;
+}
+
+/*
+ * Is str in the shared heap?  The granule it's in says which arena(s)
+ * it could be in.
+ */
+bool ssm_owns(const char *str)
+{
+  size_t granule = (size_t) str >> SSM_GRANULE_SHIFT;
+  Arena *a;
+  int slot;
   int i;
 
-  string_space = (char *) malloc(MAX_STRING);
-  if (!string_space)
+  for (slot = REGISTRY_SLOT(granule); ssm_registry[slot].used;
+       slot = (slot + 1) & (SSM_REGISTRY - 1))
   {
-    bugf("SSM: Can't allocate %ld bytes shared string space.", MAX_STRING);
-    raise(SIGSEGV);
+    if (ssm_registry[slot].granule != granule)
+      continue;
+    for (i = 0; i < 2; i++)
+    {
+      if (!ssm_registry[slot].arena[i])
+	continue;
+      a = &ssm_arena[ssm_registry[slot].arena[i] - 1];
+      if (str >= a->base && str < a->end)
+	return TRUE;
+    }
+    return FALSE;
   }
+  return FALSE;
+}
 
-  top_string = string_space + MAX_STRING - 1;
-  ssm_buf_head = (BufEntry *) string_space;
-  HEADER_SIZE = (int) ((char *) &ssm_buf_head->buf[0] - (char *) ssm_buf_head);
+/*
+ * Add arena to (or with fAdd FALSE, take it out of) the registry
+ * entries for the granules it covers.  A new granule goes in the first
+ * slot on its probe that no arena is using any more.
+ */
+static void ssm_register(int arena, bool fAdd)
+{
+  size_t granule;
+  size_t last;
+  short *who;
+  int spare;
+  int slot;
+
+  granule = (size_t) ssm_arena[arena].base >> SSM_GRANULE_SHIFT;
+  last = (size_t) (ssm_arena[arena].end - 1) >> SSM_GRANULE_SHIFT;
+  for (; granule <= last; granule++)
+  {
+    for (slot = REGISTRY_SLOT(granule), spare = -1; ssm_registry[slot].used
+	 && ssm_registry[slot].granule != granule;
+	 slot = (slot + 1) & (SSM_REGISTRY - 1))
+      if (spare < 0 && !ssm_registry[slot].arena[0]
+	  && !ssm_registry[slot].arena[1])
+	spare = slot;
+
+    if (!ssm_registry[slot].used && spare >= 0)
+      slot = spare;
+    ssm_registry[slot].used = TRUE;
+    ssm_registry[slot].granule = granule;
+    who = ssm_registry[slot].arena;
+    if (!fAdd)
+      who[who[0] == arena + 1 ? 0 : 1] = 0;
+    else
+      who[who[0] ? 1 : 0] = arena + 1;
+  }
+}
+
+/*
+ * Free p, merging it with free neighbours where the result still fits.
+ */
+static void ssm_coalesce(BufEntry * p)
+{
+  BufEntry *n;
 
-  walk = ssm_buf_head;
-  for (i = 0;; i++)
+  if ((n = ssm_after(p)) && n->usage == 0
+      && p->size + HEADER_SIZE + n->size <= SSM_MAX_SIZE)
   {
-    walk->usage = 0;
-    walk->size = CHUNK_SIZE - HEADER_SIZE;
-    if (i < MAX_CHUNKS - 1)
+    if (sweep_at == n)
+      sweep_at = p;
+    bin_unlink(n);
+    p->size += HEADER_SIZE + n->size;
+    if ((n = ssm_after(p)))
+      n->prev = p->size;
+  }
+
+  if ((n = ssm_before(p)) && n->usage == 0
+      && n->size + HEADER_SIZE + p->size <= SSM_MAX_SIZE)
+  {
+    if (sweep_at == p)
+      sweep_at = n;
+    bin_unlink(n);
+    n->size += HEADER_SIZE + p->size;
+    p = n;
+    if ((n = ssm_after(p)))
+      n->prev = p->size;
+  }
+
+  bin_link(p);
+}
+
+/* for alarm_update crosschecking */
+int ssm_dup_count;
+int ssm_loops;
+int ssm_recent_loops;
+
+/*
+ * Take a chunk of at least len from the bins, splitting off the rest.
+ * Every chunk in a bin above len's fits, so only len's own is searched.
+ */
+static BufEntry *ssm_alloc(int len)
+{
+  BufEntry *p = NULL;
+  BufEntry *rest;
+  BufEntry *n;
+  int bin;
+
+  for (bin = bin_of(len); bin < SSM_BINS && !p; bin++)
+    for (p = ssm_bin[bin]; p; p = p->next)
     {
-      walk->next = (BufEntry *) ((char *) walk + CHUNK_SIZE);
-      walk = walk->next;
-      continue;
+      ssm_recent_loops++;
+      ssm_loops++;
+      if (p->size >= len)
+	break;
     }
 
-    walk->next = 0;
-    break;
+  if (!p)
+    return NULL;
+
+  bin_unlink(p);
+  p->usage = 1;
+
+  /* If there is at least header size excess break it up */
+  if (p->size - len >= HEADER_SIZE + 8)
+  {
+    /* WARNING! - DONT REMOVE THE CASTS BELOW! - Fusion */
+    rest = (BufEntry *) ((char *) p + HEADER_SIZE + len);
+    rest->size = p->size - (len + HEADER_SIZE);
+    rest->prev = len;
+    p->size = len;
+    if ((n = ssm_after(rest)))
+      n->prev = rest->size;
+    ssm_coalesce(rest);
   }
 
-  ssm_buf_free = ssm_buf_head;
-  temp_string_hash = (TempHash **) calloc(sizeof(TempHash *),
-					  MAX_KEY_HASH);
+  return p;
 }
 
-int defrag_heap()
+static unsigned int ssm_hash_str(const char *str, int *len)
 {
-  /*
-     * Walk through the shared heap and merge adjacent free blocks.
-     * Free blocks are merged in str_free if free->next is free but
-     * if the block preceding free is free, it stays unmerged. I would
-     * rather not have the heap as a DOUBLE linked list for 2 reasons...
-     *  (1) Extra 4 bytes per struct uses more mem
-     *  (2) Speed - don't want to bog down str_ functions with heap management
-     * The "orphaned" blocks will eventually be either merged or reused.
-     * The str_dup function will call defrag if it cant allocate a buf.
-   */
+  const unsigned char *s = (const unsigned char *) str;
+  unsigned int hash = 2166136261U;
+
+  for (; *s; s++)
+    hash = (hash ^ *s) * 16777619U;
+  *len = (const char *) s - str;
+  return hash;
+}
+
+/*
+ * Add an arena of chunks to the heap.
+ */
+static bool ssm_grow(int chunks)
+{
+  BufEntry *walk;
+  char *base;
+  long size;
+  int arena;
+  int i;
+
+  /* the slot of one that's been given back will do */
+  for (arena = 0; arena < ssm_arena_top && ssm_arena[arena].base; arena++)
+    ;
+  if (arena >= SSM_MAX_ARENAS)
+    return FALSE;
+
+  size = (long) chunks * CHUNK_SIZE + HEADER_SIZE;
+  if (!(base = (char *) malloc(size)))
+  {
+    bugf("SSM: Can't allocate %ld bytes shared string space.", size);
+    return FALSE;
+  }
+
+  for (i = 0; i < chunks; i++)
+  {
+    walk = (BufEntry *) (base + i * CHUNK_SIZE);
+    walk->size = CHUNK_SIZE - HEADER_SIZE;
+    walk->prev = i > 0 ? CHUNK_SIZE - HEADER_SIZE : 0;
+    bin_link(walk);
+  }
+
+  walk = (BufEntry *) (base + chunks * CHUNK_SIZE);
+  walk->size = 0;
+  walk->prev = CHUNK_SIZE - HEADER_SIZE;
+  walk->usage = 1;
+  walk->next = NULL;
+  if (ssm_fence)
+    ssm_fence->next = (BufEntry *) base;
+  else
+    ssm_buf_head = (BufEntry *) base;
+  ssm_fence = walk;
+
+  ssm_arena[arena].base = base;
+  ssm_arena[arena].end = base + size;
+  ssm_arena[arena].fence = walk;
+  ssm_register(arena, TRUE);
+  if (arena == ssm_arena_top)
+    ssm_arena_top++;
+  ssm_arenas++;
+  MAX_STRING += size;
+  return TRUE;
+}
+
+/*
+ * Give a grown arena back if nothing in it is in use.  The first one
+ * stays, as ssm_buf_head.
+ */
+static bool ssm_release(int arena)
+{
+  Arena *a = &ssm_arena[arena];
+  BufEntry *p;
+  BufEntry *before = NULL;
+  long size = a->end - a->base;
+  int i;
+
+  if (arena == 0)
+    return FALSE;
+
+  for (p = (BufEntry *) a->base; p != a->fence; p = ssm_after(p))
+    if (p->usage != 0)
+      return FALSE;
+
+  for (i = 0; i < ssm_arena_top; i++)
+    if (ssm_arena[i].base && ssm_arena[i].fence->next == (BufEntry *) a->base)
+      before = ssm_arena[i].fence;
+  if (!before)
+  {
+    bugf("SSM: arena %d is not on the chain.", arena);
+    return FALSE;
+  }
+
+  for (p = (BufEntry *) a->base; p != a->fence; p = ssm_after(p))
+    bin_unlink(p);
+
+  before->next = a->fence->next;
+  if (ssm_fence == a->fence)
+    ssm_fence = before;
+
+  ssm_register(arena, FALSE);
+  free(a->base);
+  a->base = a->end = NULL;
+  a->fence = NULL;
+  ssm_arenas--;
+  MAX_STRING -= size;
+  ssm_released++;
+  ssm_reclaimed += size;
+  return TRUE;
+}
+
+static int ssm_arena_of(BufEntry * head)
+{
+  int i;
+
+  for (i = 0; i < ssm_arena_top; i++)
+    if (ssm_arena[i].base == (char *) head)
+      return i;
+  return -1;
+}
 
-  BufEntry *walk, *last_free, *next;
-  int merges = 0;
-  ssm_buf_free = 0;
-  for (walk = ssm_buf_head, last_free = 0; walk; walk = next)
+void init_string_space()
+{
+  HEADER_SIZE = (int) offsetof(BufEntry, buf);
+  if (!ssm_grow(MAX_CHUNKS))
+    raise(SIGSEGV);
+
+  ssm_hash = (BufEntry **) calloc(sizeof(BufEntry *), SSM_HASH);
+}
+
+/*
+ * Chunks are merged as they're freed, so there's nothing left for a
+ * stop-the-world defrag to do.  What the heap can't do for itself is
+ * shrink: ssm_sweep() walks it a slice at a time in the idle end of
+ * each pulse, and gives back grown arenas that have emptied, as long as
+ * there's as much free elsewhere.  A pass starts every SSM_SWEEP_TIME
+ * seconds, or now with defrag_heap().
+ */
+void defrag_heap()
+{
+  sweep_last = 0;
+}
+
+void ssm_sweep(long long idle)
+{
+  BufEntry *p;
+  long long deadline;
+  long size;
+  int n;
+
+  if (!sweep_at)
   {
-    next = walk->next;
-    if (walk->usage > 0)
+    if (current_time - sweep_last < SSM_SWEEP_TIME)
+      return;
+    sweep_at = ssm_buf_head;
+    sweep_arena = 0;
+    sweep_empty = TRUE;
+    sweep_bytes = 0;
+  }
+
+  deadline = current_usec() + UMIN(idle, SSM_SWEEP_USEC);
+  for (n = 1; sweep_at; n++)
+  {
+    if (n % 64 == 0 && current_usec() >= deadline)
+      return;
+
+    p = sweep_at;
+    if (p->size != 0)
     {
-      /* this block is in use so set last_free to NULL */
-      last_free = 0;
+      if (p->usage != 0)
+	sweep_empty = FALSE;
+      sweep_bytes += HEADER_SIZE + p->size;
+      sweep_at = ssm_after(p);
       continue;
     }
-    else if (!last_free)
-    {
-      /* OK found a NEW free block, set last_free and move to next */
-      last_free = walk;
-      if (!ssm_buf_free)
-	ssm_buf_free = walk;
 
-      continue;
-    }
-    else
-    {
-      /* previous block free so merge walk into last_free and move on */
-      if ((long) last_free->size + (long) walk->size <= CHUNK_SIZE)
-      {
-	merges++;
-	last_free->size += walk->size + HEADER_SIZE;
-	last_free->next = walk->next;
-	last_free->usage = 0;
-      }
-      else
-	last_free = walk;
-    }
+    /* the end of an arena: it goes back if it looked empty and is */
+    sweep_at = p->next;
+    size = ssm_arena[sweep_arena].end - ssm_arena[sweep_arena].base;
+    if (sweep_empty && MAX_STRING - sAllocString - size >= size
+	&& ssm_release(sweep_arena))
+      log_f("SSM: gave back a %ld byte arena, heap now %ld bytes.",
+	    size, MAX_STRING);
+    sweep_arena = sweep_at ? ssm_arena_of(sweep_at) : 0;
+    sweep_empty = TRUE;
   }
 
-  if (merges)
-    log_f("SSM: defrag_heap: made %d block merges.", merges);
-  else
-    log_f("SSM: defrag_heap: resulted in 0 merges.");
+  ssm_sweeps++;
+  sweep_last = current_time;
+}
 
-  /* Start count over again */
-  numFree = 0;
-  return merges;
+/*
+ * How far through the heap the current pass is, -1 between passes.
+ */
+int ssm_sweep_progress()
+{
+  if (!sweep_at)
+    return -1;
+  return (int) (sweep_bytes * 100 / UMAX(MAX_STRING, 1));
 }
 
 
@@ -191,19 +537,15 @@ int defrag_heap()
  * Dup a string into shared space. If string exists, the usage count
  * gets incremented and the reference is returned. If the string does
  * not exist in heap, space is allocated and usage is 1.
- * This is a linked list first fit algorithm, so strings can be
- * freed. Upon bootup, there is a seperate hash table constructed in order
- * to do crunching, then the table is destroyed.
+ * Every string in the heap is in a hash by content, so dups of a
+ * string that's already there share it whether or not they're made
+ * from the same pointer.
  */
-
-/* for alarm_update crosschecking */
-int ssm_dup_count;
-int ssm_loops;
-int ssm_recent_loops;
-
 char *_str_dup(const char *str, const char *caller)
 {
   BufEntry *ptr;
+  BufEntry **chain;
+  unsigned int hash;
   int len;
   int rlen;
   char *str_new;
@@ -214,7 +556,7 @@ char *_str_dup(const char *str, const char *caller)
   if (!str || !*str)
     return &str_empty[0];
 
-  if (str > string_space && str < top_string)
+  if (ssm_owns(str))
   {
     ptr = (BufEntry *) (str - HEADER_SIZE);
     if (ptr->usage <= 0)
@@ -228,7 +570,21 @@ char *_str_dup(const char *str, const char *caller)
     return (char *) str;
   }
 
-  rlen = len = (int) strlen(str) + 1;
+  hash = ssm_hash_str(str, &len);
+  chain = &ssm_hash[hash & (SSM_HASH - 1)];
+  for (ptr = *chain; ptr; ptr = ptr->next)
+  {
+    ssm_recent_loops++;
+    ssm_loops++;
+    if (ptr->hash == hash && ptr->usage < 32766 && !strcmp(ptr->buf, str))
+    {
+      ptr->usage++;
+      nInternString++;
+      return &ptr->buf[0];
+    }
+  }
+
+  rlen = len = len + 1;
 
   /* 
    * Round up to machine dependant address size.
@@ -239,42 +595,23 @@ char *_str_dup(const char *str, const char *caller)
   if ((len + HEADER_SIZE) & addrSizeMask)
     len += addrTypeSize - ((len + HEADER_SIZE) & addrSizeMask);
 
-RETRY:
-  for (ptr = ssm_buf_free; ptr; ptr = ptr->next)
+  ptr = len <= SSM_MAX_SIZE ? ssm_alloc(len) : NULL;
+  if (!ptr && len <= SSM_MAX_SIZE && ssm_grow(SSM_GROW_CHUNKS))
   {
-    ssm_recent_loops++;
-    ssm_loops++;
-    if (ptr->usage == 0 && ptr->size >= len)
-      break;
+    log_f("SSM: grew the shared string heap to %ld bytes.", MAX_STRING);
+    ptr = ssm_alloc(len);
   }
 
-  if (ptr)
-    ptr->usage = 1;
-  
   if (!ptr)
   {
-    if (numFree > 1)
-      numFree++;
-
-    if (numFree >= MAX_FREE)
-    {
-      int merges;
-      log_f("SSM: Attempting to optimize shared string heap.");
-      merges = defrag_heap();
-      
-      /* goto is fine because defrag will return 0 next time */
-      if (merges)
-	goto RETRY;
-    }
-    
     /* A one time toggle just for bugging purposes */
-    if (!Full)
+    if (!Full && len <= SSM_MAX_SIZE)
     {
       bugf("SSM: The shared string heap is full!");
       Full = 1;
     }
 
-    str_new = (char *) malloc(rlen);
+    str_new = (char *) mem_get(rlen, caller, MEM_OVERFLOW);
     strcpy(str_new, str);
     sOverFlowString += rlen;
     nOverFlowString++;
@@ -282,58 +619,35 @@ RETRY:
       hwOverFlow=sOverFlowString;
     return str_new;
   }
-  /* If there is at least header size excess break it up */
-  else if (ptr->size - len >= (HEADER_SIZE+8))
-  {
-    BufEntry *temp;
-    /* WARNING! - DONT REMOVE THE CASTS BELOW! - Fusion */
-    temp = (BufEntry *) ((char *) ptr + HEADER_SIZE + len);
-    temp->size = ptr->size - (len + HEADER_SIZE);
-    temp->next = ptr->next;
-    temp->usage = 0;
-    ptr->size = len;
-    ptr->next = temp;
-    
-    ssm_buf_free = temp;
-  }
-  else
-  {
-    if (ptr != ssm_buf_free)
-      ssm_buf_free->usage--;	/* buf_free was skipped */
-    
-    /* spec: don't start from the start of the heap again! */
-    for ( ; ssm_buf_free; ssm_buf_free = ssm_buf_free->next)
-    {
-      ssm_loops++;
-      ssm_recent_loops++;
-      if (ssm_buf_free->usage == 0)
-	break;
-    }
-  }
-  
+
   str_new = (char *) &ptr->buf[0];
   strcpy(str_new, str);
   ptr->caller=caller;
+  ptr->hash = hash;
+  ptr->next = *chain;
+  *chain = ptr;
   nAllocString++;
   sAllocString += ptr->size + HEADER_SIZE;
+  mem_count(mem_site(caller, MEM_SHARED), ptr->size + HEADER_SIZE);
 
   return str_new;
 }
 
 /*
  * If string is in shared space, decrement usage, if usage then is 0,
- * free the chunk and attempt to merge with next node. Other
- * strings are freed with standard free.
+ * take it out of the hash and free the chunk, merging it with its
+ * neighbours. Other strings are freed with standard free.
  * Never call free/delete externally on a shared string.
  */
 void _free_string(char *str, const char *caller)
 {
   BufEntry *ptr;
+  BufEntry **chain;
 
   if (!str || str == &str_empty[0])
     return;
 
-  if (str > string_space && str < top_string)
+  if (ssm_owns(str))
   {
     ptr = (BufEntry *) (str - HEADER_SIZE);
 
@@ -343,48 +657,29 @@ void _free_string(char *str, const char *caller)
     {
       bugf("SSM: free_string: multiple free/invalid from %s: %20.20s",
 	   caller, (char *)&ptr->buf[0]);
+      ptr->usage = 0;
       return;
     }
 
-    numFree++;
-    sAllocString -= (ptr->size + HEADER_SIZE);
-    nAllocString--;
-
-    if (!ssm_buf_free || ssm_buf_free > ptr)
-      ssm_buf_free = ptr;
-
-    if (fBootDb)
-    {
-      TempHash *ptr;
-      TempHash *walk;
-      int ihash = strlen(str) % MAX_KEY_HASH;
-
-      for (ptr = temp_string_hash[ihash]; ptr; ptr = ptr->next)
+    /* by the stored hash, in case someone has written on the string */
+    for (chain = &ssm_hash[ptr->hash & (SSM_HASH - 1)]; *chain;
+	 chain = &(*chain)->next)
+      if (*chain == ptr)
       {
-	if (ptr->str != str)
-	  continue;
-	else if (ptr == temp_string_hash[ihash])
-	  temp_string_hash[ihash] = ptr->next;
-	else
-	  for (walk = temp_string_hash[ihash]; walk; walk = walk->next)
-	  {
-	    if (walk->next == ptr)
-	    {
-	      walk->next = ptr->next;
-	      break;
-	    }
-	  }
-
-	free(ptr);
+	*chain = ptr->next;
 	break;
       }
-    }
+
+    sAllocString -= (ptr->size + HEADER_SIZE);
+    nAllocString--;
+    mem_count(mem_site(ptr->caller, MEM_SHARED), -(ptr->size + HEADER_SIZE));
+    ssm_coalesce(ptr);
     return;
   }
 
   sOverFlowString -= strlen(str) + 1;
   nOverFlowString--;
-  free(str);
+  mem_put(str);
 }
 
 
@@ -431,17 +726,6 @@ char *_fread_string(FILE * fp, const char *caller)
 
     case '~':
       *ptr = '\0';
-      if (fBootDb)
-      {
-	ptr = temp_hash_find(buf);
-	if (ptr)
-	  return _str_dup(ptr, caller);
-
-	ptr = _str_dup(buf, caller);
-	temp_hash_add(ptr);
-	return ptr;
-      }
-
       ptr=_str_dup(buf, caller);
       tail_chain();
       return ptr;
@@ -487,17 +771,6 @@ char *_fread_string_eol(FILE * fp, const char *caller)
     case '\n':
     case '\r':
       *ptr = '\0';
-      if (fBootDb)
-      {
-	ptr = temp_hash_find(buf);
-	if (ptr)
-	  return _str_dup(ptr, caller);
-
-	ptr = _str_dup(buf, caller);
-	temp_hash_add(ptr);
-	return ptr;
-      }
-
       return _str_dup(buf, caller);
     }
   }
@@ -551,73 +824,3 @@ void temp_fread_string(FILE * fp, char *buf)
     }
   }
 }
-
-
-/* Lookup the string in the boot-time hash table. */
-char *temp_hash_find(const char *str)
-{
-  TempHash *ptr;
-  int len;
-  int ihash;
-
-  if (!fBootDb || !*str)
-    return 0;
-
-  len = strlen(str);
-  ihash = len % MAX_KEY_HASH;
-
-  for (ptr = temp_string_hash[ihash]; ptr; ptr = ptr->next)
-  {
-    if (*ptr->str != *str)
-      continue;
-    else if (strcmp(ptr->str, str))
-      continue;
-    else
-      return ptr->str;
-  }
-
-  return 0;
-}
-
-
-/*
- * Add a reference in the temporary hash table.
- * String is still in the linked list structure but
- * reference is kept here for quick lookup at boot time;
- */
-void temp_hash_add(char *str)
-{
-  int len;
-  int ihash;
-  TempHash *add;
-
-  if (!fBootDb || !*str || (str <= string_space && str >= top_string))
-    return;
-
-  len = strlen(str);
-  ihash = len % MAX_KEY_HASH;
-  add = (TempHash *) malloc(sizeof(TempHash));
-  add->next = temp_string_hash[ihash];
-  temp_string_hash[ihash] = add;
-  add->len = len;
-  add->str = str;
-}
-
-/* Free the temp boot string hash table */
-void boot_done(void)
-{
-  TempHash *ptr, *next;
-  int ihash;
-
-  for (ihash = 0; ihash < MAX_KEY_HASH; ihash++)
-  {
-    for (ptr = temp_string_hash[ihash]; ptr; ptr = next)
-    {
-      next = ptr->next;
-      free(ptr);
-    }
-  }
-
-  free(temp_string_hash);
-  temp_string_hash = 0;		/* Bug check in case someone accesses later */
-}
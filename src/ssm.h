@@ -37,72 +37,92 @@
 
 typedef struct BE BufEntry;
 
+/*
+ * Chunks sit end to end in arenas.  Each knows its own size and
+ * the size of the one before it, so a freed chunk can be merged with
+ * free neighbours on either side straight away.  An in-use chunk is on
+ * the intern hash chain for its string; a free one is on the bin list
+ * for its size, and keeps the bin back-pointer in its first bytes.
+ * Each arena ends in a fence: a chunk of size 0 that is never free,
+ * whose next is the first chunk of the next arena.
+ */
 struct BE
 {
-  BufEntry *next;
+  BufEntry *next;             /* hash chain in use, bin list when free */
   uintType size;              /* size of the chunk (regardless of NULL CHAR) */
-  intType usage;	      /* how many pointers to the string */
+  uintType prev;              /* size of the chunk before, 0 if first */
+  intType usage;	      /* how many pointers to the string, 0 if free */
   intType ref;		      /* for reference checking */
+  unsigned int hash;          /* of the string, for the intern table */
   const char *caller;         /* who allocated this chunk originally */
   char buf[1];		      /* chunk starts here */
 };
 
-/*
- * This is for the temporary hashing of strings at bootup to speedup
- * comparison/crunching of the string space. The temp_string_hash will
- * be freed after boot_done() is called.
- */
-typedef struct TH TempHash;
-
-struct TH
-{
-  TempHash *next;
-  intType len;
-  char *str;
-};
-
-extern TempHash **temp_string_hash;
+#define BIN_PREV(p)	( *(BufEntry **) (p)->buf )
 
 /* These are the original Merc vars in db.c */
 extern char str_empty[1];
-extern char *string_space;
-extern char *top_string;
 extern long nAllocString;
 extern long sAllocString;
 extern long nOverFlowString;
 extern long sOverFlowString;
 extern long hwOverFlow;
-extern int numFree;
+extern long nInternString;
 extern bool Full;
+extern int ssm_arenas;
+extern long ssm_sweeps;
+extern long ssm_released;
+extern long ssm_reclaimed;
 
-int defrag_heap(void);
+void defrag_heap(void);
+int ssm_sweep_progress(void);
+BufEntry *ssm_walk(BufEntry *);
 char *_str_dup(const char *, const char *);      /* str_dup is now a macro */
 void _free_string(char *, const char *);         /* another macro          */
 char *_fread_string(FILE *, const char *);       /* fread_string as well   */
 char *fread_word_dup(FILE *);       /* Implement later to check words also */
-void temp_hash_add(char *);
-char *temp_hash_find(const char *);
 
 /*
- * ssm_buf_head points to start of shared space,
- * ssm_buf_free points to next free block
+ * ssm_buf_head points to start of shared space
  */
-extern BufEntry *ssm_buf_head, *ssm_buf_free;
+extern BufEntry *ssm_buf_head;
 
-/* To allocate more memory increase MAX_CHUNKS */
+/*
+ * The heap starts as one arena of MAX_CHUNKS chunks and grows by an
+ * arena of SSM_GROW_CHUNKS whenever a string won't fit, up to
+ * SSM_MAX_ARENAS.  MAX_STRING is how big it has got.
+ */
 #ifndef MAX_CHUNKS
 #define               MAX_CHUNKS      85
 #endif
+#define               SSM_GROW_CHUNKS 16
+#define               SSM_MAX_ARENAS  256
 #define               CHUNK_SIZE      0xfff0	/* Don't mess with this */
 extern long MAX_STRING;
 extern int HEADER_SIZE;
 extern long tot;
 
 /*
- * Not sure what is a good value for MAX_FREE 
- * If a dup fails str_dup will not defrag unless the number
- * of numFree >= MAX_FREE. numFree is NOT the current number of free blocks,
- * it is just a counter so defrag doesnt start dragging the game in the
- * case of a lot of failed dups.
+ * Free chunks are binned by size: one bin per 8 bytes up to SSM_SMALL,
+ * then one per power of two up to CHUNK_SIZE.  Strings are interned in
+ * a hash of SSM_HASH buckets (a power of two).
+ */
+#define   SSM_SMALL       512
+#define   SSM_SMALL_BINS  ( SSM_SMALL / 8 )
+#define   SSM_BINS        ( SSM_SMALL_BINS + 7 )
+#define   SSM_HASH        16384
+
+/*
+ * ssm_owns() finds a pointer's arena through a registry of the
+ * 2^SSM_GRANULE_SHIFT byte granules each arena covers.  Arenas are
+ * bigger than a granule, so no granule has more than two.
+ */
+#define   SSM_GRANULE_SHIFT 19
+#define   SSM_REGISTRY    2048
+
+/*
+ * ssm_sweep() starts a pass every SSM_SWEEP_TIME seconds and spends at
+ * most SSM_SWEEP_USEC of each pulse's idle time on it.
  */
-#define   MAX_FREE     1000
+#define   SSM_SWEEP_TIME  60
+#define   SSM_SWEEP_USEC  2000
@@ -244,6 +244,12 @@ typedef struct sysdata_type           SYS_DATA_TYPE;
 typedef struct  money_type    MONEY_TYPE;
 typedef struct buf_data_struct BUF_DATA_STRUCT;
 typedef struct hash_entry_tp  HASH_ENTRY;
+typedef struct out_seg        OUT_SEG;
+typedef struct out_queue      OUT_QUEUE;
+typedef struct out_cast       OUT_CAST;
+typedef struct slab_type      SLAB_TYPE;
+typedef struct slab           SLAB;
+typedef struct name_key       NAME_KEY;
 
 /*
  * Function types.
@@ -1462,7 +1462,7 @@ void char_update( void )
 		paf->duration--;
 	    
 	        /* We need a check here for spells that keep working... */
-	        if ( paf->type == skill_lookup( "blood leach" ) )
+	        if ( paf->type == gsn_blood_leach )
 	        {
                    if ( paf->caster != NULL && !IS_NPC(paf->caster))
                    {
@@ -1475,7 +1475,7 @@ void char_update( void )
                       damage( ch, ch, paf->caster->pcdata->vamp_level * 20, TYPE_UNDEFINED );
                    }	           
 	        } 
-              if ( paf->type == skill_lookup( "black hand" ) )
+              if ( paf->type == gsn_black_hand )
 	        {
                    if ( paf->caster != NULL && !IS_NPC(paf->caster))
                    {
@@ -1483,7 +1483,7 @@ void char_update( void )
                       ch->hit -= paf->modifier;
                    }	           
 	        }    
-              if (  ( paf->type == skill_lookup( "adrenaline bonus" ) )
+              if (  ( paf->type == gsn_adrenaline_bonus )
                  && ( ch->fighting == NULL )
                  && ( ch->hit > 10 )   )
               {
@@ -1621,7 +1621,7 @@ void check_vamp( CHAR_DATA *ch )
 {
    /* If vampire is outside, then (s)he suffers damage */
 
-   if ( is_affected( ch, skill_lookup( "cloak:darkness" ) ) )
+   if ( is_affected( ch, gsn_cloak_darkness ) )
      return;
 
    if (   IS_OUTSIDE( ch ) 
@@ -1724,7 +1724,7 @@ void obj_update( void )
      if ( IS_SET( obj->item_apply, ITEM_APPLY_HEATED ) 
          && number_range( 0, 100 ) < 25   )
       {
-        REMOVE_BIT( obj->item_apply, ITEM_APPLY_HEATED );
+        set_item_apply( obj, ITEM_APPLY_HEATED, FALSE );
 	  if ( obj->carried_by != NULL )
 	  {
 	    act( "Your $p @@acools off@@N!!", obj->carried_by, obj, NULL, TO_CHAR );
@@ -1830,6 +1830,9 @@ void aggr_update( void )
      * -- Stephen
      */
     
+    static ROOM_INDEX_DATA **hot;
+    static int hot_max;
+    ROOM_INDEX_DATA *room;
     CHAR_DATA *wch;
     CHAR_DATA *wch_next;
     CHAR_DATA *ch;
@@ -1838,15 +1841,18 @@ void aggr_update( void )
     CHAR_DATA *vch_next;
     CHAR_DATA *victim;
      OBJ_DATA *wield;
+    int nhot;
+    int i;
 
-    CREF( wch_next, CHAR_NEXT );
+    /* mob_prog.c puts mobs with act progs waiting on first_mpact_ch */
+    CREF( wch_next, CHAR_NEXTMPACT );
 
-    for ( wch = first_char; wch != NULL; wch = wch_next )
+    for ( wch = first_mpact_ch; wch != NULL; wch = wch_next )
     {
-	wch_next = wch->next;
+	wch_next = wch->next_mpact_ch;
     if ( wch->is_free != FALSE )
       continue;
-	if ( IS_NPC(wch) && wch->mpactnum > 0 &&
+	if ( IS_NPC(wch) && wch->in_room != NULL &&
 	     wch->in_room->area->nplayer > 0 )
 	{
 	  MPROG_ACT_LIST *mpact;
@@ -1857,92 +1863,127 @@ void aggr_update( void )
 	                          mpact->vo, ACT_PROG );
 	    /* Lets hope this check works until something better is in place.
 	     * -- Alty */
-	    if ( wch->hit < -10 )
+	    if ( wch->is_free != FALSE || wch->hit < -10 )
 	      break;
 	    wch->first_mpact = mpact->next;
 	    PUT_FREE(mpact, mpact_free);
 	  }
-	  if ( wch->hit < -10 )
+	  if ( wch->is_free != FALSE || wch->hit < -10 )
 	    continue;
 	  wch->mpactnum = 0;
 	  wch->first_mpact = NULL;
 	  wch->last_mpact = NULL;
+	  UNLINK(wch, first_mpact_ch, last_mpact_ch, next_mpact_ch,
+	         prev_mpact_ch);
 	}
-       
-	if ( (IS_NPC( wch ) )
-	||   wch->level >= LEVEL_IMMORTAL
-	||   wch->in_room == NULL )
+    }
+    CUREF( wch_next );
+
+    /*
+     * Aggression only happens in rooms with both players and aggressive
+     * mobs in them, and char_to_room keeps a list of those.  Fights move
+     * people about, so take a copy of it first.
+     */
+    nhot = 0;
+    for ( room = first_hot_room; room != NULL; room = room->next_hot )
+	nhot++;
+    if ( nhot > hot_max )
+    {
+	if ( hot != NULL )
+	    dispose( hot, hot_max * sizeof( *hot ) );
+	hot_max = UMAX( nhot, hot_max * 2 );
+	hot = getmem( hot_max * sizeof( *hot ) );
+    }
+    nhot = 0;
+    for ( room = first_hot_room; room != NULL; room = room->next_hot )
+	hot[nhot++] = room;
+
+    for ( i = 0; i < nhot; i++ )
+    {
+	room = hot[i];
+	if ( room->first_pc == NULL || room->first_aggr == NULL )
 	    continue;
-        CREF( ch_next, CHAR_NEXTROOM );
-	for ( ch = wch->in_room->first_person; ch != NULL; ch = ch_next )
+
+        CREF( wch_next, CHAR_NEXTKIND );
+	for ( wch = room->first_pc; wch != NULL; wch = wch_next )
 	{
-	    int count;
-
-	    ch_next     = ch->next_in_room;
-
-	    if ( !IS_NPC(ch)
-	    ||   !IS_SET(ch->act, ACT_AGGRESSIVE)
-	    ||   ch->fighting != NULL
-	    ||   ch->hunting != NULL
-	    ||   IS_AFFECTED(ch, AFF_CHARM)
-	    ||   !IS_AWAKE(ch)
-	    ||   ( IS_SET(ch->act, ACT_WIMPY) && IS_AWAKE(wch) )
-	    ||   !can_see( ch, wch ) )
+	    wch_next = wch->next_kind;
+	    if ( IS_NPC( wch )
+	    ||   wch->level >= LEVEL_IMMORTAL
+	    ||   wch->in_room != room )
 		continue;
+	    CREF( ch_next, CHAR_NEXTKIND );
+	    for ( ch = room->first_aggr; ch != NULL; ch = ch_next )
+	    {
+		int count;
+
+		ch_next     = ch->next_kind;
+
+		if ( !IS_NPC(ch)
+		||   ch->in_room != room
+		||   !IS_SET(ch->act, ACT_AGGRESSIVE)
+		||   ch->fighting != NULL
+		||   ch->hunting != NULL
+		||   IS_AFFECTED(ch, AFF_CHARM)
+		||   !IS_AWAKE(ch)
+		||   ( IS_SET(ch->act, ACT_WIMPY) && IS_AWAKE(wch) )
+		||   !can_see( ch, wch ) )
+		    continue;
 
 	    
-	   if (  ( IS_AFFECTED( wch, AFF_SNEAK )  || item_has_apply( wch, ITEM_APPLY_SNEAK ) )
-	      && ( number_percent() < 50 + ( 2 * ( get_psuedo_level( wch ) - get_psuedo_level( ch ) ) )   )  )
-	      continue;
-	    /*
-	     * Ok we have a 'wch' player character and a 'ch' npc aggressor.
-	     * MAG - wch can be an intelligent NPC.
-	     * Now make the aggressor fight a RANDOM pc victim in the room,
-	     *   giving each 'vch' an equal chance of selection.
-	     */
-	    count       = 0;
-	    victim      = NULL;
-            CREF( vch_next, CHAR_NEXTROOM );
-	    for ( vch = wch->in_room->first_person; vch != NULL; vch = vch_next )
-	    {
-		vch_next = vch->next_in_room;
+	       if (  ( IS_AFFECTED( wch, AFF_SNEAK )  || item_has_apply( wch, ITEM_APPLY_SNEAK ) )
+		  && ( number_percent() < 50 + ( 2 * ( get_psuedo_level( wch ) - get_psuedo_level( ch ) ) )   )  )
+		  continue;
+		/*
+		 * Ok we have a 'wch' player character and a 'ch' npc aggressor.
+		 * MAG - wch can be an intelligent NPC.
+		 * Now make the aggressor fight a RANDOM pc victim in the room,
+		 *   giving each 'vch' an equal chance of selection.
+		 */
+		count       = 0;
+		victim      = NULL;
+		CREF( vch_next, CHAR_NEXTROOM );
+		for ( vch = room->first_person; vch != NULL; vch = vch_next )
+		{
+		    vch_next = vch->next_in_room;
 
-		if ( (!IS_NPC(vch) || IS_SET(vch->act,ACT_INTELLIGENT))
-		&&   vch->level < LEVEL_IMMORTAL
-		&&   ( !IS_SET(ch->act, ACT_WIMPY) || !IS_AWAKE(vch) )
-		&&   can_see( ch, vch )
-            &&   ( !( IS_UNDEAD( ch ) && IS_VAMP( vch ) )  )  )
+		    if ( (!IS_NPC(vch) || IS_SET(vch->act,ACT_INTELLIGENT))
+		    &&   vch->level < LEVEL_IMMORTAL
+		    &&   ( !IS_SET(ch->act, ACT_WIMPY) || !IS_AWAKE(vch) )
+		    &&   can_see( ch, vch )
+		&&   ( !( IS_UNDEAD( ch ) && IS_VAMP( vch ) )  )  )
+		    {
+			if ( number_range( 0, count ) == 0 )
+			    victim = vch;
+			count++;
+		    }
+		}
+		CUREF( vch_next );
+		if ( victim == NULL )
 		{
-		    if ( number_range( 0, count ) == 0 )
-			victim = vch;
-		    count++;
+	    /*	bug( "Aggr_update: null victim.", count );    */
+		    continue;
 		}
-	    }
-            CUREF( vch_next );
-	    if ( victim == NULL )
-	    {
-	/*	bug( "Aggr_update: null victim.", count );    */
+		if ( IS_SET( victim->in_room->room_flags, ROOM_SAFE ) )
 		continue;
-	    }
-	    if ( IS_SET( victim->in_room->room_flags, ROOM_SAFE ) )
-            continue;
 
-	    act( "$n growls at $N!", victim, NULL, ch, TO_NOTVICT );
-	    act( "$N growls at you!  Uh-oh!!", victim, NULL, ch, TO_CHAR );
-	    act( "You growl at $N.  Get $M!!", ch, NULL, victim, TO_CHAR );
+		act( "$n growls at $N!", victim, NULL, ch, TO_NOTVICT );
+		act( "$N growls at you!  Uh-oh!!", victim, NULL, ch, TO_CHAR );
+		act( "You growl at $N.  Get $M!!", ch, NULL, victim, TO_CHAR );
 	    
-	    wield = get_eq_char( ch, WEAR_HOLD_HAND_L );
-	    if ( wield != NULL
-	      && wield->item_type == ITEM_WEAPON
-	      && wield->value[3] == 11 
-              && victim->fighting == NULL )
-	       do_backstab( ch, victim->name );
-	    else
-	       multi_hit( ch, victim, TYPE_UNDEFINED );
+		wield = get_eq_char( ch, WEAR_HOLD_HAND_L );
+		if ( wield != NULL
+		  && wield->item_type == ITEM_WEAPON
+		  && wield->value[3] == 11 
+		  && victim->fighting == NULL )
+		   do_backstab( ch, victim->name );
+		else
+		   multi_hit( ch, victim, TYPE_UNDEFINED );
+	    }
+	    CUREF( ch_next );
 	}
-        CUREF( ch_next );
+        CUREF( wch_next );
     }
-    CUREF( wch_next );
     return;
 }
 
@@ -2019,102 +2060,431 @@ void rooms_update( void )
 extern void build_save_flush(void);
 
 /*
- * Handle all kinds of updates.
- * Called once per pulse from game loop.
- * Random times to defeat tick-timing clients and players.
+ * The pulse scheduler.  update_handler is called once per pulse from
+ * the game loop and runs whichever subsystems have come due.
+ *
+ * update_handler used to keep a static countdown per subsystem and
+ * decrement them all every pulse, so whatever happened to come due
+ * together ran together: violence and mobiles landed on the same pulse
+ * every four seconds and you could feel it.  Each subsystem is now a
+ * PULSE_JOB with a deadline on the monotonic clock, kept in a small
+ * min-heap.  Every pulse we run whatever has come due, in table order
+ * for ties.
+ *
+ * - Heavy jobs are started off out of phase with each other, and only
+ *   one heavy job runs in a pulse; another one that comes due in the
+ *   same pulse waits for the next one.  That doesn't change its cadence.
+ * - A job that is late by a whole period or more doesn't run several
+ *   times to catch up.  It runs once, the missed runs are counted, and
+ *   it is re-anchored to now.
+ * - How late each run was is kept as a histogram, in pulses, for
+ *   'schedstat'.
  */
-void update_handler( void )
+
+#define PJ_HEAVY	1	/* don't share a pulse with other heavy jobs */
+
+#define SCHED_LATE_BUCKETS	5	/* on time, 1, 2-3, 4-7, 8+ pulses late */
+
+typedef struct pulse_job PULSE_JOB;
+
+struct pulse_job
 {
-    static  int     pulse_message;
-    static  int     objfun_check;
-    static  int     pulse_area;
-    static  int	    pulse_rooms;
-    static  int     pulse_mobile;
-    static  int     pulse_gain;
-    static  int     pulse_violence;
-    static  int     pulse_point;
-    static  int     pulse_auction;
-    extern  int     saving_area;
-    extern  bool    auction_flop;
+    char *	name;
+    void	(*fun) args( ( void ) );
+    int		period_min;	/* in pulses */
+    int		period_max;	/* same as min unless it's randomised */
+    int		phase;		/* pulses before the first run */
+    int		flags;
+    int		pstat;		/* PSTAT_ slot, -1 if it times itself */
+    long long	due;		/* when it should run, usec           */
+    long long	deadline;	/* heap key: due, plus any deferral   */
+    int		heap_index;
+    long	runs;
+    long	deferred;
+    long	skipped;
+    long	late[SCHED_LATE_BUCKETS];
+};
+
+static void pulse_area_job	args( ( void ) );
+static void pulse_violence_job	args( ( void ) );
+static void pulse_point_job	args( ( void ) );
+
+static PULSE_JOB pulse_job_table[] =
+{
+    { "area",     pulse_area_job,     PULSE_AREA / 2, 3 * PULSE_AREA / 2,
+      3 * PULSE_PER_SECOND / 2, PJ_HEAVY, PSTAT_AREA },
+    { "rooms",    rooms_update,       PULSE_ROOMS, PULSE_ROOMS,
+      5 * PULSE_PER_SECOND / 4, PJ_HEAVY, PSTAT_ROOMS },
+    { "message",  message_update,     PULSE_MESSAGE, PULSE_MESSAGE, 1, 0,
+      PSTAT_MESSAGE },
+    { "auction",  auction_update,     PULSE_AUCTION, PULSE_AUCTION, 1, 0,
+      PSTAT_AUCTION },
+    { "objfun",   objfun_update,      PULSE_OBJFUN, PULSE_OBJFUN, 3, 0,
+      PSTAT_OBJFUN },
+    { "violence", pulse_violence_job, PULSE_VIOLENCE, PULSE_VIOLENCE,
+      1, PJ_HEAVY, PSTAT_VIOLENCE },
+    { "mobile",   mobile_update,      PULSE_MOBILE, PULSE_MOBILE,
+      1 + PULSE_VIOLENCE / 2, PJ_HEAVY, PSTAT_MOBILE },
+    { "gain",     gain_update,        5 * PULSE_PER_SECOND,
+      8 * PULSE_PER_SECOND, 5, 0, PSTAT_GAIN },
+    { "point",    pulse_point_job,    PULSE_TICK, PULSE_TICK,
+      PULSE_PER_SECOND / 4 + PULSE_VIOLENCE / 4, PJ_HEAVY, -1 },
+    { NULL }
+};
+
+static PULSE_JOB *	pulse_heap[sizeof( pulse_job_table ) / sizeof( PULSE_JOB )];
+static int		pulse_heap_top	= 0;
+static bool		pulse_sched_up	= FALSE;
+
+/* Main loop accounting, kept by pulse_sleep() */
+static long		pulse_count	= 0;
+static long		pulse_overruns	= 0;
+static long		pulse_dropped	= 0;
+static long		pulse_over[SCHED_LATE_BUCKETS];
+static long long	next_pulse	= 0;
 
-    if ( saving_area )
-	build_save(); /* For incremental area saving */
 
 
-    if ( --pulse_area     <= 0 )
+/*
+ * Microseconds on the monotonic clock.  Only good for differences.
+ */
+long long current_usec( void )
+{
+#if defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    if ( clock_gettime( CLOCK_MONOTONIC, &ts ) == 0 )
+	return (long long) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+#endif
     {
-      pulse_area      = number_range( PULSE_AREA / 2, 3 * PULSE_AREA / 2 );
-      area_update     ( );
-      build_save_flush();
+	struct timeval tv;
+
+	gettimeofday( &tv, NULL );
+	return (long long) tv.tv_sec * 1000000 + tv.tv_usec;
     }
+}
+
+
+
+static void pulse_area_job( void )
+{
+    area_update( );
+    build_save_flush( );
+    slab_trim_all( );
+}
+
+static void pulse_violence_job( void )
+{
+    alarm_update( );
+    violence_update( );
+}
+
+static void pulse_point_job( void )
+{
+    long long start;
+
+    start = current_usec( );
+    weather_update( );
+    pstat_record( PSTAT_WEATHER, start );
+
+    start = current_usec( );
+    char_update( );
+    pstat_record( PSTAT_CHAR, start );
+
+    start = current_usec( );
+    obj_update( );
+    pstat_record( PSTAT_OBJ, start );
+
+    start = current_usec( );
+    quest_update( );
+    pstat_record( PSTAT_QUEST, start );
+
+    cmd_stat_update( );
+
+    /* This will log the number of perms being used...
+     * fgrep the log file to get results...
+     */
+    /*   perm_update( ); */
+}
+
 
-    if ( --pulse_rooms   <= 0 )
+
+/* Heap order: earliest deadline first, table order breaks ties. */
+static bool pulse_before( PULSE_JOB *a, PULSE_JOB *b )
+{
+    if ( a->deadline != b->deadline )
+	return a->deadline < b->deadline;
+    return a < b;
+}
+
+static void pulse_heap_set( int i, PULSE_JOB *job )
+{
+    pulse_heap[i]   = job;
+    job->heap_index = i;
+}
+
+static void pulse_sift( int i )
+{
+    PULSE_JOB *job = pulse_heap[i];
+
+    while ( i > 0 && pulse_before( job, pulse_heap[( i - 1 ) / 2] ) )
     {
-       pulse_rooms 	= PULSE_ROOMS;
-       rooms_update();
+	pulse_heap_set( i, pulse_heap[( i - 1 ) / 2] );
+	i = ( i - 1 ) / 2;
     }
-        
-    if ( --pulse_message <= 0 )
+
+    for ( ; ; )
     {
-       pulse_message = PULSE_MESSAGE;
-       message_update();
+	int child = 2 * i + 1;
+
+	if ( child >= pulse_heap_top )
+	    break;
+	if ( child + 1 < pulse_heap_top
+	&&   pulse_before( pulse_heap[child + 1], pulse_heap[child] ) )
+	    child++;
+	if ( !pulse_before( pulse_heap[child], job ) )
+	    break;
+	pulse_heap_set( i, pulse_heap[child] );
+	i = child;
     }
+    pulse_heap_set( i, job );
+}
+
+static int pulse_period( PULSE_JOB *job )
+{
+    if ( job->period_min == job->period_max )
+	return job->period_min;
+    return number_range( job->period_min, job->period_max );
+}
+
+static void pulse_sched_init( long long now )
+{
+    PULSE_JOB *job;
+
+    for ( job = pulse_job_table; job->name != NULL; job++ )
+    {
+	job->due      = now + (long long) job->phase * PULSE_USEC;
+	job->deadline = job->due;
+	pulse_heap_set( pulse_heap_top++, job );
+	pulse_sift( job->heap_index );
+    }
+    pulse_sched_up = TRUE;
+}
+
+/*
+ * Push a job's next run out to period pulses from now; the auction
+ * does this whenever an item flops.
+ */
+static void pulse_sched_restart( char *name, long long now )
+{
+    PULSE_JOB *job;
+
+    for ( job = pulse_job_table; job->name != NULL; job++ )
+	if ( !str_cmp( job->name, name ) )
+	{
+	    job->due      = now + (long long) pulse_period( job ) * PULSE_USEC;
+	    job->deadline = job->due;
+	    pulse_sift( job->heap_index );
+	    return;
+	}
+}
+
+static int pulse_late_bucket( long long late )
+{
+    long pulses = (long) ( late / PULSE_USEC );
+
+    if ( pulses < 1 )  return 0;
+    if ( pulses < 2 )  return 1;
+    if ( pulses < 4 )  return 2;
+    if ( pulses < 8 )  return 3;
+    return 4;
+}
+
+
+
+void update_handler( void )
+{
+    extern  int     saving_area;
+    extern  bool    auction_flop;
+    long long now = current_usec( );
+    bool heavy = FALSE;
+
+    if ( !pulse_sched_up )
+	pulse_sched_init( now );
+
+    if ( saving_area )
+	build_save(); /* For incremental area saving */
 
     if ( auction_flop )
     {
-       pulse_auction = PULSE_AUCTION;
+       pulse_sched_restart( "auction", now );
        auction_flop = FALSE;
     }
-    
-    if ( --pulse_auction <= 0 )
+
+    /* Half a pulse of slack, so a job due mid-pulse doesn't wait a whole one */
+    while ( pulse_heap_top > 0 && pulse_heap[0]->deadline <= now + PULSE_USEC / 2 )
     {
-       pulse_auction = PULSE_AUCTION;
-       auction_update();
+	PULSE_JOB *job = pulse_heap[0];
+	long long late;
+	long long start;
+	int period;
+
+	if ( IS_SET( job->flags, PJ_HEAVY ) && heavy )
+	{
+	    /* Someone heavy already went this pulse, try the next one */
+	    job->deadline = now + PULSE_USEC;
+	    job->deferred++;
+	    pulse_sift( 0 );
+	    continue;
+	}
+
+	late = UMAX( 0, now - job->due );
+	job->late[pulse_late_bucket( late )]++;
+	job->runs++;
+	if ( IS_SET( job->flags, PJ_HEAVY ) )
+	    heavy = TRUE;
+
+	start = current_usec( );
+	(*job->fun) ( );
+	if ( job->pstat >= 0 )
+	    pstat_record( job->pstat, start );
+
+	period = pulse_period( job );
+	if ( late >= (long long) period * PULSE_USEC )
+	{
+	    /* Missed whole runs: count them, don't try to make them up */
+	    job->skipped += late / ( (long long) period * PULSE_USEC );
+	    job->due = now + (long long) period * PULSE_USEC;
+	}
+	else
+	    job->due += (long long) period * PULSE_USEC;
+	job->deadline = job->due;
+	pulse_sift( 0 );
     }
-    
-    if ( --objfun_check <= 0 )
+
     {
-      objfun_check = PULSE_OBJFUN;
-      objfun_update();
+	long long start = current_usec( );
+
+	aggr_update( );
+	pstat_record( PSTAT_AGGR, start );
     }
-    
-    
-    if ( --pulse_violence <= 0 )
+    tail_chain( );
+    return;
+}
+
+
+
+/*
+ * Sleep until the next pulse is due, called at the end of every pass of
+ * the game loop.  next_pulse is a monotonic deadline that advances by
+ * exactly one pulse each time, so a slow pulse is made up for by a short
+ * (or no) sleep after it rather than the whole clock slipping.  If we
+ * fall more than a second behind the backlog is dropped.
+ */
+void pulse_sleep( void )
+{
+    long long now = current_usec( );
+
+    if ( next_pulse == 0 )
+	next_pulse = now;
+    next_pulse += PULSE_USEC;
+    pulse_count++;
+
+    if ( now > next_pulse )
     {
-      alarm_update();
-      pulse_violence  = PULSE_VIOLENCE;
-      violence_update ( );
+	pulse_overruns++;
+	pulse_over[pulse_late_bucket( now - next_pulse )]++;
+	if ( now - next_pulse > (long long) PULSE_PER_SECOND * PULSE_USEC )
+	{
+	    pulse_dropped += (long) ( ( now - next_pulse ) / PULSE_USEC );
+	    next_pulse = now;
+	}
+	return;
     }
 
-    if ( --pulse_mobile   <= 0 )
+    while ( now < next_pulse )
     {
-      pulse_mobile    = PULSE_MOBILE;
-      mobile_update   ( );
+	struct timeval stall_time;
+	long long wait = next_pulse - now;
+
+	stall_time.tv_sec  = (long) ( wait / 1000000 );
+	stall_time.tv_usec = (long) ( wait % 1000000 );
+	if ( select( 0, NULL, NULL, NULL, &stall_time ) < 0 && errno != EINTR )
+	{
+	    perror( "Pulse_sleep: select: stall" );
+	    exit( 1 );
+	}
+	now = current_usec( );
     }
+    return;
+}
+
+
+/*
+ * How long until the next pulse is due, for work that can wait.
+ */
+long long pulse_idle( void )
+{
+    long long left;
 
-    if ( --pulse_gain    <= 0 )
+    if ( next_pulse == 0 )
+	return 0;
+    left = next_pulse + PULSE_USEC - current_usec( );
+    return left > 0 ? left : 0;
+}
+
+
+
+void do_schedstat( CHAR_DATA *ch, char *argument )
+{
+    char buf[MAX_STRING_LENGTH];
+    PULSE_JOB *job;
+    long long now = current_usec( );
+    int i;
+
+    if ( !str_cmp( argument, "reset" ) )
     {
-       gain_update();
-       pulse_gain = PULSE_PER_SECOND * number_range(5,8);
+	for ( job = pulse_job_table; job->name != NULL; job++ )
+	{
+	    job->runs = job->deferred = job->skipped = 0;
+	    for ( i = 0; i < SCHED_LATE_BUCKETS; i++ )
+		job->late[i] = 0;
+	}
+	pulse_count = pulse_overruns = pulse_dropped = 0;
+	for ( i = 0; i < SCHED_LATE_BUCKETS; i++ )
+	    pulse_over[i] = 0;
+	send_to_char( "Scheduler statistics reset.\n\r", ch );
+	return;
     }
-    
-    if ( --pulse_point    <= 0 )
+
+    send_to_char( "Job       Period    Next   Runs  Defer   Skip |"
+		  "  On time     1   2-3   4-7    8+\n\r", ch );
+    for ( job = pulse_job_table; job->name != NULL; job++ )
     {
-      pulse_point     = PULSE_TICK;
-      weather_update  ( );
-      char_update     ( );
-      obj_update      ( );
-      quest_update    ( );
-        
-        /* This will log the number of perms being used...
-         * fgrep the log file to get results...
-         */
-         
-     /*   perm_update( ); */
+	char period[32];
+
+	if ( job->period_min == job->period_max )
+	    sprintf( period, "%d.%ds", job->period_min / PULSE_PER_SECOND,
+		( job->period_min % PULSE_PER_SECOND ) * 10 / PULSE_PER_SECOND );
+	else
+	    sprintf( period, "%d-%ds", job->period_min / PULSE_PER_SECOND,
+		job->period_max / PULSE_PER_SECOND );
+
+	sprintf( buf, "%-8s %7s %6lds %6ld %6ld %6ld | %8ld %5ld %5ld %5ld %5ld%s\n\r",
+	    job->name, period,
+	    pulse_sched_up ? (long) ( ( job->deadline - now ) / 1000000 ) : 0L,
+	    job->runs, job->deferred, job->skipped,
+	    job->late[0], job->late[1], job->late[2], job->late[3], job->late[4],
+	    IS_SET( job->flags, PJ_HEAVY ) ? "  heavy" : "" );
+	send_to_char( buf, ch );
     }
 
-    aggr_update( );
-    tail_chain( );
+    sprintf( buf, "\n\rMain loop: %ld pulses, %ld overran "
+	"(<1:%ld 1:%ld 2-3:%ld 4-7:%ld 8+:%ld pulses), %ld dropped.\n\r",
+	pulse_count, pulse_overruns, pulse_over[0],
+	pulse_over[1], pulse_over[2], pulse_over[3], pulse_over[4],
+	pulse_dropped );
+    send_to_char( buf, ch );
     return;
 }
 
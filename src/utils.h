@@ -95,6 +95,8 @@ char *_str_dup args((const char *str, const char *caller));
 char *_fread_string_eol args((FILE * fp, const char *caller));
 #define free_string(x) _free_string((x), _caller)
 void _free_string args((char *pstr, const char *caller));
+bool ssm_owns args((const char *str));
+void ssm_sweep args((long long idle));
 
 /*
  * Updated pointer referencing, curtesy of Spectrum, from Beyond the Veil
@@ -111,11 +113,14 @@ struct obj_ref_type
   struct obj_ref_type *next;
   OBJ_DATA **var;
   int type;                    /* OBJ_xxxx */
+  const char *caller;
 };
 
 #define CHAR_NEXT         1
 #define CHAR_NEXTROOM     2
 #define CHAR_NULL         3
+#define CHAR_NEXTKIND     4
+#define CHAR_NEXTMPACT    5
 
 struct char_ref_type
 {
@@ -123,17 +128,33 @@ struct char_ref_type
   struct char_ref_type *next;
   CHAR_DATA **var;
   int type;
+  const char *caller;
 };
 
+/*
+ * The reference lists are stacks: a loop pushes its next pointer with
+ * CREF/OREF and pops it with CUREF/OUREF before it returns, so the pop
+ * is normally of the top entry and is done here without a call.
+ * Anything else goes to the unreference functions, which complain.
+ */
+extern struct obj_ref_type *obj_ref_list;
+extern struct char_ref_type *char_ref_list;
+
 #define OREF(v, type) do { \
-static struct obj_ref_type s={FALSE,NULL,NULL,type}; s.var=&v; \
+static struct obj_ref_type s={FALSE,NULL,NULL,type,_caller}; s.var=&v; \
 obj_reference(&s); } while(0)
-#define OUREF(var) obj_unreference(&var);
+#define OUREF(v) do { \
+if ( obj_ref_list && obj_ref_list->var == &(v) ) { \
+  obj_ref_list->inuse=FALSE; obj_ref_list=obj_ref_list->next; } \
+else obj_unreference(&(v)); } while(0)
 
 #define CREF(v, type) do { \
-static struct char_ref_type s={FALSE,NULL,NULL,type}; s.var=&v; \
+static struct char_ref_type s={FALSE,NULL,NULL,type,_caller}; s.var=&v; \
 char_reference(&s); } while(0)
-#define CUREF(var) char_unreference(&var);
+#define CUREF(v) do { \
+if ( char_ref_list && char_ref_list->var == &(v) ) { \
+  char_ref_list->inuse=FALSE; char_ref_list=char_ref_list->next; } \
+else char_unreference(&(v)); } while(0)
 
 
 
@@ -162,6 +183,7 @@ char_reference(&s); } while(0)
 #define IS_IMMORTAL(ch)         (get_trust(ch) >= LEVEL_IMMORTAL)
 #define IS_HERO(ch)             (get_trust(ch) >= LEVEL_HERO)
 #define IS_AFFECTED(ch, sn)     (IS_SET((ch)->affected_by, (sn)))
+#define item_has_apply(ch, bit) (IS_SET((ch)->worn_apply, (bit)))
 /* #define IS_WERE(ch) (IS_NPC(ch) ? IS_SET(ch->act, ACT_WEREWOLF) : IS_SET(ch->pcdata->pflags,PFLAG_WEREWOLF) )
 */
 #define IS_GOOD(ch)             (ch->alignment >= 350)
@@ -431,7 +453,7 @@ do { \
     return; \
   } \
   if (log&&mem_log) log_f("dispose(%p) from %s:%d", (mem), __FILE__, __LINE__); \
-  free((mem)); \
+  mem_put((mem)); \
   (mem) = NULL; \
 } while(0)
 
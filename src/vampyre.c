@@ -217,7 +217,7 @@ bool spell_embrace(int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj )
        send_to_char( "A choice awaits you....shall you accept this destiny and feed upon mortals, or shall you\n\r", victim );
        send_to_char( "seek @@Wcleansing@@N from this @@dEternal Damnation@@N???\n\r", victim );
 
-       victim->pcdata->learned[skill_lookup( "feed" )] = 90 ;
+       victim->pcdata->learned[gsn_feed] = 90 ;
      }
 
 
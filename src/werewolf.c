@@ -462,7 +462,7 @@ bool spell_tribe_claw(int sn, int level, CHAR_DATA *ch, void *vo, OBJ_DATA *obj
        act( "$n suddenly reaches out and claws $N to shreds!", ch, NULL, victim, TO_NOTVICT );
        act( "$n then takes $N's throat in $s mouth, and tears it out!", ch, NULL, victim, TO_NOTVICT );
        act( "$N goes into convulsions, then slowly steadies, then peers up at $n with adoration.", ch, NULL, victim, TO_NOTVICT );
-       victim->pcdata->learned[skill_lookup( "scent" )] = 90 ;
+       victim->pcdata->learned[gsn_scent] = 90 ;
      }
 
 
@@ -377,8 +377,7 @@ void do_rename (CHAR_DATA* ch, char* argument)
 	/* Rename the character and save him to a new file */
 	/* NOTE: Players who are level 1 do NOT get saved under a new name */
 
-	free_string (victim->name);
-	victim->name = str_dup (capitalize(new_name));
+	char_rename (victim, capitalize(new_name));
 	
 	save_char_obj (victim);
 	